@@ -0,0 +1,296 @@
+//
+// Benchmark driver: runs the search on a matrix of datasets x maxdepth x minsup x weighted/unweighted and writes the
+// measures in JSON or CSV. A previous result file can be given as a baseline to detect the performance regressions.
+//
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <cstdio>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "benchmarkDataset.h"
+#include "dl85.h"
+#include "globals.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// the measures of a configuration. The times are those of the repeated runs, the warm-up runs excluded
+struct Result {
+    string dataset;
+    int ntransactions, nattributes, maxdepth, minsup;
+    bool weighted;
+    float error;
+    int latticeSize, depthTwoCalls, cacheHits;
+    vector<double> times;
+    long peakRssKb;
+
+    string key() const {
+        return dataset + "|" + to_string(maxdepth) + "|" + to_string(minsup) + "|" + to_string(weighted);
+    }
+
+    double median() const {
+        vector<double> sorted = times;
+        sort(sorted.begin(), sorted.end());
+        int n = (int) sorted.size();
+        return (n % 2) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+    }
+};
+
+// the reference measures of a configuration read from a baseline file
+struct Reference {
+    double time;
+    float error;
+    int latticeSize;
+};
+
+static float runSearch(Dataset &dataset, int maxdepth, int minsup, float *weights, int timeLimit, Tree *tree) {
+    search(dataset.supports.data(), dataset.ntransactions, dataset.nattributes, dataset.nclasses, dataset.data.data(),
+           dataset.target.data(), maxdepth, minsup, 0, false, nullptr, nullptr, nullptr, weights, true, true, true,
+           false, true, false, timeLimit, false, nullptr, nullptr, true, false, 0, nullptr, MSE_CRITERION, 1, nullptr, 0,
+           1, nullptr, tree);
+    return tree->trainingError;
+}
+
+static Result benchmark(Dataset &dataset, int maxdepth, int minsup, bool weighted, int warmup, int repeat,
+                        int timeLimit) {
+    // the weights are drawn with a fixed seed so that the runs are comparable
+    vector<float> weights;
+    if (weighted) {
+        mt19937 generator(0);
+        uniform_real_distribution<float> distribution(0.5f, 1.5f);
+        for (int i = 0; i < dataset.ntransactions; ++i) weights.push_back(distribution(generator));
+    }
+
+    Result result{dataset.name, dataset.ntransactions, dataset.nattributes, maxdepth, minsup, weighted, 0, 0, 0, 0, {}, 0};
+    for (int run = 0; run < warmup + repeat; ++run) {
+        Tree tree{};
+        auto start = steady_clock::now();
+        result.error = runSearch(dataset, maxdepth, minsup, (weighted) ? weights.data() : nullptr, timeLimit, &tree);
+        double time = duration<double>(steady_clock::now() - start).count();
+        if (run < warmup) continue;
+        result.times.push_back(time);
+        result.latticeSize = tree.latSize;
+        result.depthTwoCalls = tree.stats.depthTwoCalls;
+        result.cacheHits = tree.stats.cacheHits;
+    }
+    return result;
+}
+
+// run benchmark in a child process and get its peak resident memory, in KB on Linux. The high-water mark of a process
+// never decreases, so the one of this process would be the largest of the configurations already run. The measures are
+// sent back through a pipe
+static Result benchmarkInChild(Dataset &dataset, int maxdepth, int minsup, bool weighted, int warmup, int repeat,
+                               int timeLimit) {
+    Result result{dataset.name, dataset.ntransactions, dataset.nattributes, maxdepth, minsup, weighted, 0, 0, 0, 0, {}, 0};
+    int fds[2];
+    if (pipe(fds) != 0) throw runtime_error("Cannot create a pipe for " + result.key());
+    pid_t pid = fork();
+    if (pid < 0) throw runtime_error("Cannot fork for " + result.key());
+    if (pid == 0) {
+        close(fds[0]);
+        FILE *out = fdopen(fds[1], "w");
+        try {
+            Result child = benchmark(dataset, maxdepth, minsup, weighted, warmup, repeat, timeLimit);
+            fprintf(out, "%.9g %d %d %d %d", child.error, child.latticeSize, child.depthTwoCalls, child.cacheHits,
+                    (int) child.times.size());
+            for (double time : child.times) fprintf(out, " %.17g", time);
+            fclose(out);
+            _exit(0);
+        } catch (exception &e) {
+            cerr << e.what() << endl;
+            _exit(1);
+        }
+    }
+
+    close(fds[1]);
+    FILE *in = fdopen(fds[0], "r");
+    int ntimes = 0;
+    bool received = fscanf(in, "%f %d %d %d %d", &result.error, &result.latticeSize, &result.depthTwoCalls,
+                       &result.cacheHits, &ntimes) == 5;
+    result.times.resize(max(ntimes, 0));
+    for (double &time : result.times) received = received && fscanf(in, "%lf", &time) == 1;
+    fclose(in);
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0 || !received ||
+        result.times.empty())
+        throw runtime_error("The benchmark of " + result.key() + " failed");
+    result.peakRssKb = usage.ru_maxrss;
+    return result;
+}
+
+static void writeJson(ostream &out, const vector<Result> &results) {
+    out << "{\"results\": [\n";
+    for (size_t r = 0; r < results.size(); ++r) {
+        const Result &res = results[r];
+        out << "{\"dataset\": \"" << res.dataset << "\", \"ntransactions\": " << res.ntransactions
+            << ", \"nattributes\": " << res.nattributes << ", \"maxdepth\": " << res.maxdepth << ", \"minsup\": "
+            << res.minsup << ", \"weighted\": " << res.weighted << ", \"error\": " << res.error
+            << ", \"lattice_size\": " << res.latticeSize << ", \"depth_two_calls\": " << res.depthTwoCalls
+            << ", \"cache_hits\": " << res.cacheHits << ", \"time_median\": " << res.median() << ", \"time_min\": "
+            << *min_element(res.times.begin(), res.times.end()) << ", \"time_max\": "
+            << *max_element(res.times.begin(), res.times.end()) << ", \"peak_rss_kb\": " << res.peakRssKb << "}"
+            << ((r + 1 < results.size()) ? "," : "") << "\n";
+    }
+    out << "]}\n";
+}
+
+static const char *CSV_HEADER = "dataset,ntransactions,nattributes,maxdepth,minsup,weighted,error,lattice_size,"
+                                "depth_two_calls,cache_hits,time_median,time_min,time_max,peak_rss_kb";
+
+static void writeCsv(ostream &out, const vector<Result> &results) {
+    out << CSV_HEADER << "\n";
+    for (const Result &res : results)
+        out << res.dataset << "," << res.ntransactions << "," << res.nattributes << "," << res.maxdepth << ","
+            << res.minsup << "," << res.weighted << "," << res.error << "," << res.latticeSize << ","
+            << res.depthTwoCalls << "," << res.cacheHits << "," << res.median() << ","
+            << *min_element(res.times.begin(), res.times.end()) << ","
+            << *max_element(res.times.begin(), res.times.end()) << "," << res.peakRssKb << "\n";
+}
+
+// the raw value of a field of a JSON record written by writeJson
+static string jsonField(const string &record, const string &name) {
+    size_t start = record.find("\"" + name + "\": ");
+    if (start == string::npos) return "";
+    start += name.size() + 4;
+    size_t end = record.find_first_of(",}", start);
+    string value = record.substr(start, end - start);
+    if (!value.empty() && value[0] == '"') value = value.substr(1, value.size() - 2);
+    return value;
+}
+
+// read the median time, the error and the lattice size of each configuration of a file written by this driver
+static map<string, Reference> loadBaseline(const string &path) {
+    map<string, Reference> references;
+    ifstream file(path);
+    if (!file) throw runtime_error("Cannot read the baseline " + path);
+    vector<string> names = split(CSV_HEADER);
+    string line;
+    while (getline(file, line)) {
+        map<string, string> fields;
+        if (line.find("\"dataset\"") != string::npos) {
+            for (const string &name : names) fields[name] = jsonField(line, name);
+        } else {
+            vector<string> values = split(line);
+            if (values.size() != names.size() || values[0] == "dataset") continue;
+            for (size_t f = 0; f < names.size(); ++f) fields[names[f]] = values[f];
+        }
+        string key = fields["dataset"] + "|" + fields["maxdepth"] + "|" + fields["minsup"] + "|" + fields["weighted"];
+        references[key] = {stod(fields["time_median"]), stof(fields["error"]), stoi(fields["lattice_size"])};
+    }
+    return references;
+}
+
+// print the comparison of each configuration to the baseline and return the number of regressions
+static int compare(const vector<Result> &results, const map<string, Reference> &baseline, double tolerance) {
+    int regressions = 0;
+    cerr << "configuration (dataset|maxdepth|minsup|weighted)  baseline(s)  current(s)  ratio  status" << endl;
+    for (const Result &res : results) {
+        auto reference = baseline.find(res.key());
+        if (reference == baseline.end()) {
+            cerr << res.key() << "  -  " << res.median() << "  -  NEW" << endl;
+            continue;
+        }
+        double ratio = res.median() / max(reference->second.time, 1e-9);
+        string status = "OK";
+        // the errors are written with 9 significant digits
+        if (fabs(res.error - reference->second.error) > 1e-5 * max(1.f, fabs(reference->second.error)))
+            status = "ERROR CHANGED";
+        else if (ratio > 1 + tolerance) status = "SLOWER";
+        else if (ratio < 1 - tolerance) status = "FASTER";
+        if (res.latticeSize != reference->second.latticeSize) status += " (lattice " +
+                to_string(reference->second.latticeSize) + " -> " + to_string(res.latticeSize) + ")";
+        if (status.compare(0, 6, "SLOWER") == 0 || status.compare(0, 5, "ERROR") == 0) ++regressions;
+        cerr << res.key() << "  " << reference->second.time << "  " << res.median() << "  " << ratio << "  " << status
+             << endl;
+    }
+    return regressions;
+}
+
+static void usage() {
+    cerr << "usage: dl85_benchmark [options]\n"
+            "  --data-dir DIR       directory of the datasets (default ../../datasets)\n"
+            "  --datasets A,B       files of the datasets (default all the .txt files of the directory)\n"
+            "  --depths 2,3         maximum depths (default 3)\n"
+            "  --minsups 1          minimum supports (default 1)\n"
+            "  --weighted 0,1       unweighted (0) and/or weighted (1) runs (default 0)\n"
+            "  --warmup N           runs discarded before the measures (default 1)\n"
+            "  --repeat N           measured runs per configuration (default 3)\n"
+            "  --time-limit S       time limit of each search in seconds (default 0, no limit)\n"
+            "  --format json|csv    format of the results (default json, or the extension of --output)\n"
+            "  --output FILE        file of the results (default standard output)\n"
+            "  --baseline FILE      results of a previous run to compare with (json or csv)\n"
+            "  --tolerance T        relative slowdown reported as a regression (default 0.1)\n"
+            "Each configuration runs in a child process, whose peak resident memory is reported.\n"
+            "The exit code is 1 when a configuration is slower than the baseline or finds another error." << endl;
+}
+
+int main(int argc, char *argv[]) {
+    string dataDir = "../../datasets", format, output, baselinePath;
+    vector<string> names;
+    vector<int> depths = {3}, minsups = {1}, weightings = {0};
+    int warmup = 1, repeat = 3, timeLimit = 0;
+    double tolerance = 0.1;
+
+    for (int a = 1; a < argc; ++a) {
+        string option = argv[a];
+        if (option == "--help" || option == "-h" || a + 1 >= argc) {
+            usage();
+            return option == "--help" || option == "-h" ? 0 : 2;
+        }
+        string value = argv[++a];
+        if (option == "--data-dir") dataDir = value;
+        else if (option == "--datasets") names = split(value);
+        else if (option == "--depths") depths = splitInts(value);
+        else if (option == "--minsups") minsups = splitInts(value);
+        else if (option == "--weighted") weightings = splitInts(value);
+        else if (option == "--warmup") warmup = stoi(value);
+        else if (option == "--repeat") repeat = max(1, stoi(value));
+        else if (option == "--time-limit") timeLimit = stoi(value);
+        else if (option == "--format") format = value;
+        else if (option == "--output") output = value;
+        else if (option == "--baseline") baselinePath = value;
+        else if (option == "--tolerance") tolerance = stod(value);
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (names.empty()) names = listDatasets(dataDir);
+    if (format.empty()) format = (output.size() > 4 && output.substr(output.size() - 4) == ".csv") ? "csv" : "json";
+
+    vector<Result> results;
+    for (const string &name : names) {
+        Dataset dataset;
+        if (!loadDataset(dataDir + "/" + name, dataset)) {
+            cerr << "cannot read the dataset " << dataDir + "/" + name << endl;
+            return 2;
+        }
+        for (int maxdepth : depths)
+            for (int minsup : minsups)
+                for (int weighted : weightings) {
+                    results.push_back(benchmarkInChild(dataset, maxdepth, minsup, weighted, warmup, repeat,
+                                                       timeLimit));
+                    cerr << results.back().key() << ": " << results.back().median() << "s" << endl;
+                }
+    }
+
+    ofstream file;
+    if (!output.empty()) file.open(output);
+    ostream &out = (output.empty()) ? cout : file;
+    out.precision(9);
+    if (format == "csv") writeCsv(out, results);
+    else writeJson(out, results);
+
+    if (!baselinePath.empty()) return (compare(results, loadBaseline(baselinePath), tolerance) > 0) ? 1 : 0;
+    return 0;
+}
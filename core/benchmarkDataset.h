@@ -0,0 +1,83 @@
+//
+// Datasets of the benchmark programs: the files of the datasets directory and the helpers parsing the options
+//
+#ifndef DL85_BENCHMARK_DATASET_H
+#define DL85_BENCHMARK_DATASET_H
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <dirent.h>
+#include "globals.h"
+
+using namespace std;
+
+// a dataset in the format of the datasets directory: one transaction per line, the class then the binary features
+struct Dataset {
+    string name;
+    int ntransactions = 0, nattributes = 0, nclasses = 0;
+    vector<int> data, target; // the data are stored column by column, as expected by search
+    vector<SupportClass> supports;
+};
+
+static inline bool loadDataset(const string &path, Dataset &dataset) {
+    ifstream file(path);
+    if (!file) return false;
+    vector<vector<int>> rows;
+    string line;
+    while (getline(file, line)) {
+        stringstream stream(line);
+        vector<int> row;
+        int value;
+        while (stream >> value) row.push_back(value);
+        if (!row.empty()) rows.push_back(row);
+    }
+    if (rows.empty() || rows[0].size() < 2) return false;
+
+    string name = path.substr(path.find_last_of('/') + 1);
+    dataset.name = name.substr(0, name.find_last_of('.'));
+    dataset.ntransactions = (int) rows.size();
+    dataset.nattributes = (int) rows[0].size() - 1;
+    dataset.data.resize((size_t) dataset.ntransactions * dataset.nattributes);
+    dataset.target.resize(dataset.ntransactions);
+    for (int i = 0; i < dataset.ntransactions; ++i) {
+        if ((int) rows[i].size() != dataset.nattributes + 1) return false;
+        dataset.target[i] = rows[i][0];
+        dataset.nclasses = max(dataset.nclasses, rows[i][0] + 1);
+        for (int j = 0; j < dataset.nattributes; ++j) dataset.data[(size_t) j * dataset.ntransactions + i] = rows[i][j + 1];
+    }
+    dataset.supports.assign(dataset.nclasses, 0);
+    for (int c : dataset.target) ++dataset.supports[c];
+    return true;
+}
+
+static inline vector<string> split(const string &list) {
+    vector<string> values;
+    stringstream stream(list);
+    string value;
+    while (getline(stream, value, ',')) if (!value.empty()) values.push_back(value);
+    return values;
+}
+
+static inline vector<int> splitInts(const string &list) {
+    vector<int> values;
+    for (const string &value : split(list)) values.push_back(stoi(value));
+    return values;
+}
+
+static inline vector<string> listDatasets(const string &directory) {
+    vector<string> names;
+    DIR *dir = opendir(directory.c_str());
+    if (!dir) return names;
+    while (struct dirent *entry = readdir(dir)) {
+        string name = entry->d_name;
+        if (name.size() > 4 && name.substr(name.size() - 4) == ".txt") names.push_back(name);
+    }
+    closedir(dir);
+    sort(names.begin(), names.end());
+    return names;
+}
+
+#endif //DL85_BENCHMARK_DATASET_H
@@ -0,0 +1,343 @@
+//
+// Micro-benchmark of the cover primitives: times intersect, temporaryIntersect, temporaryIntersectSup, countDif, minusMe
+// and getSupportPerClass of the unweighted and weighted covers, on synthetic datasets of controlled size, density, number
+// of classes and weight distribution, and on the datasets of the datasets directory. The measures are reported per word
+// of the cover (ns/word) and as the bandwidth of the words read and written (GB/s), to compare layouts and SIMD variants.
+//
+#include <fstream>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include "benchmarkDataset.h"
+#include "dataManager.h"
+#include "rCoverTotalFreq.h"
+#include "rCoverWeighted.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// the measure of a primitive on a cover
+struct Measure {
+    string dataset, weights, primitive;
+    int ntransactions, nattributes, nclasses, depth;
+    double density;
+    int validWords, support;
+    long long calls;
+    double nsPerCall, nsPerWord, gbPerSecond;
+};
+
+// what the measured calls read and write, to convert the time of a call into ns/word and GB/s
+struct Traffic {
+    int words; // the words of the cover visited by a call
+    double bytes; // the bytes read and written by a call
+};
+
+// the results of the calls are accumulated here so that the compiler cannot remove them
+static volatile double sink = 0;
+
+static Dataset syntheticDataset(int ntransactions, int nattributes, double density, int nclasses, mt19937 &generator) {
+    Dataset dataset;
+    dataset.name = "synthetic";
+    dataset.ntransactions = ntransactions;
+    dataset.nattributes = nattributes;
+    dataset.nclasses = nclasses;
+    bernoulli_distribution bit(density);
+    uniform_int_distribution<int> label(0, nclasses - 1);
+    dataset.data.resize((size_t) ntransactions * nattributes);
+    for (int &value : dataset.data) value = bit(generator);
+    dataset.target.resize(ntransactions);
+    for (int &value : dataset.target) value = label(generator);
+    dataset.supports.assign(nclasses, 0);
+    for (int c : dataset.target) ++dataset.supports[c];
+    return dataset;
+}
+
+// the weights of the transactions: "uniform" in [0.5, 1.5], "exponential" of mean 1 (a few heavy transactions) or
+// "integer" bootstrap counts between 0 and 3. "none" stands for the unweighted cover
+static vector<float> drawWeights(const string &distribution, int ntransactions, mt19937 &generator) {
+    vector<float> weights(ntransactions);
+    if (distribution == "uniform") {
+        uniform_real_distribution<float> draw(0.5f, 1.5f);
+        for (float &w : weights) w = draw(generator);
+    } else if (distribution == "exponential") {
+        exponential_distribution<float> draw(1);
+        for (float &w : weights) w = draw(generator);
+    } else if (distribution == "integer") {
+        poisson_distribution<int> draw(1);
+        for (float &w : weights) w = (float) min(draw(generator), 3);
+    } else throw invalid_argument("Unknown weight distribution " + distribution);
+    return weights;
+}
+
+static double meanDensity(const Dataset &dataset) {
+    double ones = 0;
+    for (int value : dataset.data) ones += value;
+    return ones / max((size_t) 1, dataset.data.size());
+}
+
+// the time of a call in ns: the number of calls of a batch is doubled until the batch lasts minTime, then the fastest
+// of repeat batches is kept
+static double timeCall(const function<void()> &call, double minTime, int repeat, long long &calls) {
+    call(); // warm-up
+    calls = 1;
+    while (true) {
+        auto start = steady_clock::now();
+        for (long long c = 0; c < calls; ++c) call();
+        if (duration<double>(steady_clock::now() - start).count() >= minTime) break;
+        calls *= 2;
+    }
+    double best = 1e300;
+    for (int r = 0; r < repeat; ++r) {
+        auto start = steady_clock::now();
+        for (long long c = 0; c < calls; ++c) call();
+        best = min(best, duration<double>(steady_clock::now() - start).count());
+    }
+    return best * 1e9 / calls;
+}
+
+static int popcount(const bitset<M> &word) { return (int) word.count(); }
+
+// measure the primitives on the cover of the first depth positive items of the dataset
+static void measureCover(const Dataset &dataset, RCover *cover, const string &weights, int depth,
+                         double minTime, int repeat, vector<Measure> &measures) {
+    const bool weighted = weights != "none";
+    // the class words read by the statistics of a word: with two unweighted classes the second count is deduced
+    const int classWords = (!weighted && nclasses == 2) ? 1 : nclasses;
+    const int nattributes = dataset.nattributes;
+
+    // the cover measured is the intersection of depth items, each keeping the largest part of the cover so that the
+    // depth controls its size. The cover of its parent is kept as the operand of countDif and minusMe, whose difference
+    // is then the cover of the other item of the last attribute
+    bitset<M> *parent = cover->getTopBitsetArray();
+    vector<bool> used(nattributes, false);
+    for (int d = 0; d < min(depth, nattributes); ++d) {
+        int best = -1;
+        bool bestPositive = true;
+        Support bestSupport = -1;
+        for (int a = 0; a < nattributes; ++a) {
+            if (used[a]) continue;
+            for (bool item : {true, false}) {
+                Support sup = cover->temporaryIntersectSup(a, item);
+                if (sup > bestSupport) best = a, bestPositive = item, bestSupport = sup;
+            }
+        }
+        delete[] parent;
+        parent = cover->getTopBitsetArray();
+        cover->intersect(best, bestPositive);
+        used[best] = true;
+    }
+    const int validWords = cover->limit.top();
+    if (validWords == 0) {
+        cerr << dataset.name << " depth=" << depth << ": empty cover, not measured" << endl;
+        delete[] parent;
+        for (int d = 0; d < min(depth, nattributes); ++d) cover->backtrack();
+        return;
+    }
+    int support = 0, difSupport = 0;
+    vector<bitset<M> *> words;
+    vector<int> indexes;
+    for (int i = 0; i < validWords; ++i) {
+        int w = cover->validWords[i];
+        support += popcount(cover->coverWords[w].top());
+        difSupport += popcount(parent[w] & ~cover->coverWords[w].top());
+        words.push_back(&cover->coverWords[w].top());
+        indexes.push_back(w);
+    }
+    // the weights are read once per transaction counted. The items intersected with keep about half of the cover
+    const double weightBytes = (weighted) ? sizeof(float) : 0;
+
+    int attribute = 0;
+    bool positive = true;
+    // the items intersected with are visited in turn, as in the search
+    auto nextItem = [&]() {
+        positive = !positive;
+        if (positive) attribute = (attribute + 1) % nattributes;
+    };
+
+    struct Primitive {
+        string name;
+        function<void()> call;
+        Traffic traffic;
+    };
+    vector<Primitive> primitives = {
+            {"intersect", [&]() {
+                cover->intersect(attribute, positive);
+                sink = sink + cover->getSupport();
+                cover->backtrack();
+                nextItem();
+            }, {validWords, validWords * 8. * (3 + classWords) + weightBytes * support / 2}},
+            {"temporaryIntersect", [&]() {
+                pair<Supports, Support> result = cover->temporaryIntersect(attribute, positive);
+                sink = sink + result.first[0] + result.second;
+                deleteSupports(result.first);
+                nextItem();
+            }, {validWords, validWords * 8. * (2 + classWords) + weightBytes * support / 2}},
+            {"temporaryIntersectSup", [&]() {
+                sink = sink + cover->temporaryIntersectSup(attribute, positive);
+                nextItem();
+            }, {validWords, validWords * 8. * 2}},
+            {"countDif", [&]() {
+                sink = sink + cover->countDif(parent);
+            }, {validWords, validWords * 8. * 2 + weightBytes * difSupport}},
+            {"minusMe", [&]() {
+                Supports supports = cover->minusMe(parent);
+                sink = sink + supports[0];
+                deleteSupports(supports);
+            }, {validWords, validWords * 8. * (2 + classWords) + weightBytes * difSupport}},
+            {"getSupportPerClass", [&]() {
+                Supports supports = cover->getSupportPerClass(words.data(), validWords, indexes.data());
+                sink = sink + supports[0];
+                deleteSupports(supports);
+            }, {validWords, validWords * 8. * (1 + classWords) + weightBytes * support}},
+    };
+
+    for (Primitive &primitive : primitives) {
+        Measure measure{dataset.name, weights, primitive.name, dataset.ntransactions, nattributes, dataset.nclasses,
+                        depth, meanDensity(dataset), validWords, support, 0, 0, 0, 0};
+        measure.nsPerCall = timeCall(primitive.call, minTime, repeat, measure.calls);
+        measure.nsPerWord = measure.nsPerCall / primitive.traffic.words;
+        measure.gbPerSecond = primitive.traffic.bytes / measure.nsPerCall; // bytes per ns are GB/s
+        measures.push_back(measure);
+        cerr << measure.dataset << " n=" << measure.ntransactions << " density=" << measure.density << " classes="
+             << measure.nclasses << " weights=" << weights << " depth=" << depth << " " << primitive.name << ": "
+             << measure.nsPerWord << " ns/word, " << measure.gbPerSecond << " GB/s" << endl;
+    }
+    delete[] parent;
+    for (int d = 0; d < min(depth, nattributes); ++d) cover->backtrack();
+}
+
+static void measureDataset(const Dataset &dataset, const vector<string> &weightings, const vector<int> &depths,
+                           double minTime, int repeat, mt19937 &generator, vector<Measure> &measures) {
+    vector<SupportClass> supports = dataset.supports;
+    DataManager dm(supports.data(), dataset.ntransactions, dataset.nattributes, dataset.nclasses,
+                   (int *) dataset.data.data(), (int *) dataset.target.data());
+    for (const string &weights : weightings) {
+        vector<float> transactionWeights;
+        RCover *cover;
+        if (weights == "none") cover = new RCoverTotalFreq(&dm);
+        else {
+            transactionWeights = drawWeights(weights, dataset.ntransactions, generator);
+            cover = new RCoverWeighted(&dm, &transactionWeights);
+        }
+        for (int depth : depths) measureCover(dataset, cover, weights, depth, minTime, repeat, measures);
+        delete cover;
+    }
+}
+
+static const char *CSV_HEADER = "dataset,ntransactions,nattributes,density,nclasses,weights,depth,primitive,"
+                                "valid_words,support,calls,ns_per_call,ns_per_word,gb_per_s";
+
+static void writeCsv(ostream &out, const vector<Measure> &measures) {
+    out << CSV_HEADER << "\n";
+    for (const Measure &m : measures)
+        out << m.dataset << "," << m.ntransactions << "," << m.nattributes << "," << m.density << "," << m.nclasses
+            << "," << m.weights << "," << m.depth << "," << m.primitive << "," << m.validWords << "," << m.support
+            << "," << m.calls << "," << m.nsPerCall << "," << m.nsPerWord << "," << m.gbPerSecond << "\n";
+}
+
+static void writeJson(ostream &out, const vector<Measure> &measures) {
+    out << "{\"results\": [\n";
+    for (size_t r = 0; r < measures.size(); ++r) {
+        const Measure &m = measures[r];
+        out << "{\"dataset\": \"" << m.dataset << "\", \"ntransactions\": " << m.ntransactions
+            << ", \"nattributes\": " << m.nattributes << ", \"density\": " << m.density << ", \"nclasses\": "
+            << m.nclasses << ", \"weights\": \"" << m.weights << "\", \"depth\": " << m.depth << ", \"primitive\": \""
+            << m.primitive << "\", \"valid_words\": " << m.validWords << ", \"support\": " << m.support
+            << ", \"calls\": " << m.calls << ", \"ns_per_call\": " << m.nsPerCall << ", \"ns_per_word\": "
+            << m.nsPerWord << ", \"gb_per_s\": " << m.gbPerSecond << "}" << ((r + 1 < measures.size()) ? "," : "")
+            << "\n";
+    }
+    out << "]}\n";
+}
+
+static void usage() {
+    cerr << "usage: dl85_cover_benchmark [options]\n"
+            "  --transactions N,N   sizes of the synthetic datasets (default 1000,100000)\n"
+            "  --densities D,D      probability of a feature to be set in the synthetic datasets (default 0.1,0.5,0.9)\n"
+            "  --classes C,C        numbers of classes of the synthetic datasets (default 2,5)\n"
+            "  --attributes N       number of features of the synthetic datasets (default 16)\n"
+            "  --weights W,W        none, uniform, exponential and/or integer (default none,uniform)\n"
+            "  --depths 0,1,2       items intersected to build the measured cover, the larger the smaller (default 0,2)\n"
+            "  --data-dir DIR       directory of the real datasets (default ../../datasets)\n"
+            "  --datasets A,B       files of real datasets to measure too (default none)\n"
+            "  --min-time S         minimal duration of a batch of calls in seconds (default 0.05)\n"
+            "  --repeat N           batches per measure, the fastest is kept (default 3)\n"
+            "  --seed N             seed of the synthetic data and of the weights (default 0)\n"
+            "  --format json|csv    format of the results (default csv, or the extension of --output)\n"
+            "  --output FILE        file of the results (default standard output)\n"
+            "ns/word is the time of a call divided by the words of the cover, GB/s counts the cover, item and class\n"
+            "words read and written by a call and the weights of the transactions counted. Build the program with\n"
+            "-DCMAKE_BUILD_TYPE=Release to measure the optimized primitives." << endl;
+}
+
+int main(int argc, char *argv[]) {
+    string dataDir = "../../datasets", format, output;
+    vector<string> names, weightings = {"none", "uniform"};
+    vector<int> sizes = {1000, 100000}, classes = {2, 5}, depths = {0, 2};
+    vector<double> densities = {0.1, 0.5, 0.9};
+    int nattributes = 16, repeat = 3, seed = 0;
+    double minTime = 0.05;
+
+    for (int a = 1; a < argc; ++a) {
+        string option = argv[a];
+        if (option == "--help" || option == "-h" || a + 1 >= argc) {
+            usage();
+            return option == "--help" || option == "-h" ? 0 : 2;
+        }
+        string value = argv[++a];
+        if (option == "--transactions") sizes = splitInts(value);
+        else if (option == "--densities") {
+            densities.clear();
+            for (const string &density : split(value)) densities.push_back(stod(density));
+        }
+        else if (option == "--classes") classes = splitInts(value);
+        else if (option == "--attributes") nattributes = max(1, stoi(value));
+        else if (option == "--weights") weightings = split(value);
+        else if (option == "--depths") depths = splitInts(value);
+        else if (option == "--data-dir") dataDir = value;
+        else if (option == "--datasets") names = split(value);
+        else if (option == "--min-time") minTime = stod(value);
+        else if (option == "--repeat") repeat = max(1, stoi(value));
+        else if (option == "--seed") seed = stoi(value);
+        else if (option == "--format") format = value;
+        else if (option == "--output") output = value;
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (format.empty()) format = (output.size() > 5 && output.substr(output.size() - 5) == ".json") ? "json" : "csv";
+
+    mt19937 generator(seed);
+    vector<Measure> measures;
+    try {
+        for (int ntransactions : sizes)
+            for (double density : densities)
+                for (int nclass : classes) {
+                    Dataset dataset = syntheticDataset(ntransactions, nattributes, density, max(2, nclass), generator);
+                    measureDataset(dataset, weightings, depths, minTime, repeat, generator, measures);
+                }
+        for (const string &name : names) {
+            Dataset dataset;
+            if (!loadDataset(dataDir + "/" + name, dataset)) {
+                cerr << "cannot read the dataset " << dataDir + "/" + name << endl;
+                return 2;
+            }
+            measureDataset(dataset, weightings, depths, minTime, repeat, generator, measures);
+        }
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 2;
+    }
+
+    ofstream file;
+    if (!output.empty()) file.open(output);
+    ostream &out = (output.empty()) ? cout : file;
+    if (format == "json") writeJson(out, measures);
+    else writeCsv(out, measures);
+    return 0;
+}
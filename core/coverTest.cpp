@@ -0,0 +1,126 @@
+//
+// Regression test of the differences of covers used by the similarity lower bound: minusMe and countDif are compared
+// to a naive count over the transactions, on random paths of the search space of the unweighted and weighted covers.
+// The dataset given in argument and synthetic datasets of several classes are used. The exit code is 1 on a mismatch.
+//
+#include <vector>
+#include <iostream>
+#include <random>
+#include <cmath>
+#include "benchmarkDataset.h"
+#include "dataManager.h"
+#include "rCoverTotalFreq.h"
+#include "rCoverWeighted.h"
+
+using namespace std;
+
+// an item of a path: the attribute and whether the transactions have it
+typedef pair<Attribute, bool> PathItem;
+
+static Dataset syntheticDataset(int ntransactions, int nattributes, int nclasses, mt19937 &generator) {
+    Dataset dataset;
+    dataset.name = "synthetic";
+    dataset.ntransactions = ntransactions;
+    dataset.nattributes = nattributes;
+    dataset.nclasses = nclasses;
+    bernoulli_distribution bit(0.5);
+    uniform_int_distribution<int> label(0, nclasses - 1);
+    dataset.data.resize((size_t) ntransactions * nattributes);
+    for (int &value : dataset.data) value = bit(generator);
+    dataset.target.resize(ntransactions);
+    for (int &value : dataset.target) value = label(generator);
+    dataset.supports.assign(nclasses, 0);
+    for (int c : dataset.target) ++dataset.supports[c];
+    return dataset;
+}
+
+static vector<PathItem> randomPath(const Dataset &dataset, int depth, mt19937 &generator) {
+    uniform_int_distribution<int> attribute(0, dataset.nattributes - 1);
+    bernoulli_distribution positive(0.5);
+    vector<PathItem> path;
+    for (int d = 0; d < depth; ++d) path.emplace_back(attribute(generator), positive(generator));
+    return path;
+}
+
+static bool inPath(const Dataset &dataset, const vector<PathItem> &path, int tid) {
+    for (const PathItem &item : path)
+        if ((dataset.data[(size_t) dataset.ntransactions * item.first + tid] != 0) != item.second) return false;
+    return true;
+}
+
+// compare minusMe and countDif of the cover of path to the naive counts of the transactions of other not in path.
+// Like the covers, the differences only read the words of the cover of path holding one of its transactions at least.
+// Returns the number of mismatches
+static int check(const Dataset &dataset, DataManager *dm, vector<float> *weights, const vector<PathItem> &path,
+                 const vector<PathItem> &other) {
+    RCover *cover = (weights) ? (RCover *) new RCoverWeighted(dm, weights) : (RCover *) new RCoverTotalFreq(dm);
+    for (const PathItem &item : other) cover->intersect(item.first, item.second);
+    bitset<M> *otherCover = cover->getTopBitsetArray();
+    for (size_t d = 0; d < other.size(); ++d) cover->backtrack();
+    for (const PathItem &item : path) cover->intersect(item.first, item.second);
+
+    vector<bool> validWord(dm->nWords, false);
+    for (int tid = 0; tid < dataset.ntransactions; ++tid)
+        if (inPath(dataset, path, tid)) validWord[tid / M] = true;
+    vector<double> expected(::nclasses, 0);
+    for (int tid = 0; tid < dataset.ntransactions; ++tid)
+        if (validWord[tid / M] && inPath(dataset, other, tid) && !inPath(dataset, path, tid))
+            expected[dataset.target[tid]] += (weights) ? (*weights)[tid] : 1;
+
+    int mismatches = 0;
+    Supports difference = cover->minusMe(otherCover);
+    double total = 0;
+    for (int c = 0; c < ::nclasses; ++c) {
+        total += expected[c];
+        if (fabs(difference[c] - expected[c]) > 1e-3 * max(1., expected[c])) {
+            cerr << dataset.name << ((weights) ? " weighted" : "") << ": minusMe gives " << difference[c]
+                 << " transactions of the class " << c << " instead of " << expected[c] << endl;
+            ++mismatches;
+        }
+    }
+    SupportClass count = cover->countDif(otherCover);
+    if (fabs(count - total) > 1e-3 * max(1., total)) {
+        cerr << dataset.name << ((weights) ? " weighted" : "") << ": countDif gives " << count << " instead of "
+             << total << endl;
+        ++mismatches;
+    }
+
+    deleteSupports(difference);
+    delete[] otherCover;
+    delete cover;
+    return mismatches;
+}
+
+int main(int argc, char *argv[]) {
+    mt19937 generator(0);
+    vector<Dataset> datasets;
+    for (int a = 1; a < argc; ++a) {
+        Dataset dataset;
+        if (!loadDataset(argv[a], dataset)) {
+            cerr << "cannot read the dataset " << argv[a] << endl;
+            return 2;
+        }
+        datasets.push_back(dataset);
+    }
+    // sizes which are not multiples of the words, with two and more classes
+    datasets.push_back(syntheticDataset(1000, 20, 2, generator));
+    datasets.push_back(syntheticDataset(333, 15, 4, generator));
+
+    int mismatches = 0, checks = 0;
+    for (Dataset &dataset : datasets) {
+        DataManager dm(dataset.supports.data(), dataset.ntransactions, dataset.nattributes, dataset.nclasses,
+                       dataset.data.data(), dataset.target.data());
+        uniform_real_distribution<float> weight(0.5f, 1.5f);
+        vector<float> weights(dataset.ntransactions);
+        for (float &w : weights) w = weight(generator);
+        uniform_int_distribution<int> depth(0, 4);
+        for (int test = 0; test < 200; ++test) {
+            vector<PathItem> path = randomPath(dataset, depth(generator), generator);
+            vector<PathItem> other = randomPath(dataset, depth(generator), generator);
+            mismatches += check(dataset, &dm, nullptr, path, other) + check(dataset, &dm, &weights, path, other);
+            checks += 2;
+        }
+    }
+    cout << checks << " differences of covers checked, " << mismatches << " mismatches" << endl;
+    return (mismatches > 0) ? 1 : 0;
+}
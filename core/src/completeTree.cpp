@@ -0,0 +1,113 @@
+#include "completeTree.h"
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <cmath>
+#include <cctype>
+#include <algorithm>
+
+// a float literal of the generated headers, NaN for the unknown values
+static string floatLiteral(float x) {
+    if (std::isnan(x)) return "NAN";
+    if (std::isinf(x)) return (x > 0) ? "INFINITY" : "-INFINITY";
+    ostringstream out;
+    out << setprecision(9) << x;
+    string literal = out.str();
+    if (literal.find_first_of(".e") == string::npos) literal += ".";
+    return literal + "f";
+}
+
+CompleteTree::CompleteTree(const int *feature, const int *left, const int *right, const float *value, int nnodes,
+                           int nvalues) :
+        nvalues(nvalues), flat_feature(feature, feature + nnodes), flat_left(left, left + nnodes),
+        flat_right(right, right + nnodes), flat_value(value, value + (long) nnodes * nvalues) {
+    if (nnodes < 1) throw invalid_argument("The tree has no node");
+    if (nvalues < 1) throw invalid_argument("The leaves have no value");
+    vector<int> node_depth(nnodes, 0);
+    for (int node = 0; node < nnodes; ++node) {
+        if (feature[node] < 0) continue;
+        for (int child : {left[node], right[node]}) {
+            if (child <= node || child >= nnodes) throw invalid_argument("The tree arrays are not in preorder");
+            node_depth[child] = node_depth[node] + 1;
+            depth = max(depth, node_depth[child]);
+        }
+    }
+    if (depth > COMPLETE_TREE_MAX_DEPTH)
+        throw invalid_argument("The depth " + to_string(depth) + " is too high for a complete tree (at most " +
+                               to_string(COMPLETE_TREE_MAX_DEPTH) + ")");
+    this->feature.assign((1 << depth) - 1, 0);
+    this->value.assign((size_t) nvalues << depth, NAN);
+    place(0, 0, 0);
+}
+
+// copy the subtree of node at the position of depth d of the complete tree
+void CompleteTree::place(int node, int position, int d) {
+    if (d == depth) {
+        copy(&flat_value[(long) node * nvalues], &flat_value[(long) (node + 1) * nvalues],
+             &value[(long) (position - ((1 << depth) - 1)) * nvalues]);
+        return;
+    }
+    // a leaf above the last level tests any feature and is repeated in both children
+    bool leaf = flat_feature[node] < 0;
+    feature[position] = (leaf) ? 0 : flat_feature[node];
+    place((leaf) ? node : flat_left[node], 2 * position + 1, d + 1);
+    place((leaf) ? node : flat_right[node], 2 * position + 2, d + 1);
+}
+
+void CompleteTree::printConditionals(int node, int indent, string &out, int &leaf) const {
+    string spaces(indent * 4, ' ');
+    if (flat_feature[node] < 0) {
+        out += spaces + "return values + " + to_string(leaf * nvalues) + ";\n";
+        ++leaf;
+        return;
+    }
+    out += spaces + "if (x[" + to_string(flat_feature[node]) + "]) {\n";
+    printConditionals(flat_left[node], indent + 1, out, leaf);
+    out += spaces + "} else {\n";
+    printConditionals(flat_right[node], indent + 1, out, leaf);
+    out += spaces + "}\n";
+}
+
+string CompleteTree::toCppHeader(const string &name, bool conditional) const {
+    string guard = name;
+    for (char &c : guard) c = (char) toupper(c);
+    guard += "_H";
+    string out = "// Decision tree exported by DL8.5. " + name + "(x) returns the " + to_string(nvalues) +
+                 " value(s) of the leaf reached by the row x of binary features\n";
+    out += "#ifndef " + guard + "\n#define " + guard + "\n\n#include <cmath>\n\n";
+
+    if (conditional) {
+        // the values of the leaves in preorder
+        string values;
+        int nleaves = 0;
+        for (int node = 0; node < (int) flat_feature.size(); ++node) {
+            if (flat_feature[node] >= 0) continue;
+            for (int k = 0; k < nvalues; ++k)
+                values += ((nleaves || k) ? ", " : "") + floatLiteral(flat_value[(long) node * nvalues + k]);
+            ++nleaves;
+        }
+        out += "inline const float *" + name + "(const int *x) {\n";
+        out += "    static const float values[] = {" + values + "};\n";
+        int leaf = 0;
+        printConditionals(0, 1, out, leaf);
+        out += "}\n";
+    }
+    else {
+        string features, values;
+        for (int i = 0; i < (int) feature.size(); ++i) features += ((i) ? ", " : "") + to_string(feature[i]);
+        if (feature.empty()) features = "0"; // a leaf: the array is never read but cannot be empty
+        for (int i = 0; i < (int) value.size(); ++i) values += ((i) ? ", " : "") + floatLiteral(value[i]);
+        out += "static const int " + name + "_feature[] = {" + features + "};\n";
+        out += "static const float " + name + "_value[] = {" + values + "};\n\n";
+        out += "// the node i tests the feature " + name + "_feature[i]; its children are 2i+1 (feature set) and 2i+2\n";
+        out += "inline const float *" + name + "(const int *x) {\n";
+        out += "    int node = 0;\n";
+        out += "    for (int d = 0; d < " + to_string(depth) + "; ++d) node = 2 * node + 2 - (x[" + name +
+               "_feature[node]] != 0);\n";
+        out += "    return " + name + "_value + (node - " + to_string((1 << depth) - 1) + ") * " + to_string(nvalues) +
+               ";\n";
+        out += "}\n";
+    }
+    out += "\n#endif\n";
+    return out;
+}
@@ -0,0 +1,58 @@
+#ifndef COMPLETE_TREE_H
+#define COMPLETE_TREE_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// deepest tree stored in the complete layout, which has 2^depth leaves
+#define COMPLETE_TREE_MAX_DEPTH 20
+
+/**
+ * CompleteTree - a tree given by the flat preorder arrays of Tree, stored as a complete tree of its depth for the
+ * prediction of one row at a time. The node i tests feature[i] and its children are 2i+1 (feature set) and 2i+2, so a
+ * row is routed with one test per level and no branch. The leaves shallower than the depth are repeated in the
+ * positions below them. The tree can also be exported as a self-contained C++ header
+ * @param depth - the depth of the tree
+ * @param nvalues - the number of values of each leaf
+ * @param feature - the feature tested by each of the 2^depth - 1 internal positions
+ * @param value - the nvalues values of each of the 2^depth leaf positions
+ */
+class CompleteTree {
+public:
+    CompleteTree(const int *feature, const int *left, const int *right, const float *value, int nnodes,
+                 int nvalues = 1);
+
+    // the values of the leaf reached by a row of binary features
+    inline const float *evaluate(const int *row) const {
+        int node = 0;
+        for (int d = 0; d < depth; ++d) node = 2 * node + 2 - (row[feature[node]] != 0);
+        return &value[(node - ((1 << depth) - 1)) * nvalues];
+    }
+
+    /**
+     * toCppHeader - generate a C++ header defining the function "const float *name(const int *x)" which returns the
+     * values of the leaf reached by the row x, without dependency on DL8.5
+     * @param name - the name of the function
+     * @param conditional - whether the function is a nest of conditionals following the tree instead of the loop over
+     * the complete layout stored in arrays
+     */
+    string toCppHeader(const string &name, bool conditional = false) const;
+
+    int depth = 0;
+    int nvalues;
+    vector<int> feature;
+    vector<float> value;
+
+private:
+    // the tree in preorder, kept for the conditionals
+    vector<int> flat_feature, flat_left, flat_right;
+    vector<float> flat_value;
+
+    void place(int node, int position, int d);
+
+    void printConditionals(int node, int indent, string &out, int &leaf) const;
+};
+
+#endif
@@ -3,62 +3,28 @@
 //
 
 #include "dataManager.h"
+#include <stdexcept>
 
 
-DataManager::DataManager(Supports supports, int ntransactions, int nattributes, int nclasses, int *data, int *target):supports(supports), ntransactions(ntransactions), nattributes(nattributes), nclasses(nclasses) {
+DataManager::DataManager(Supports supports, int ntransactions, int nattributes, int nclasses, int *data, int *target, int ntargets):supports(supports), ntransactions(ntransactions), nattributes(nattributes), nclasses(nclasses) {
     nclasses = (nclasses == 1) ? 2 : nclasses;
     nWords = (int)ceil((float)ntransactions/M);
     b = new bitset<M> *[nattributes];
-    c = new bitset<M> *[nclasses];
 
     for (int i = 0; i < nattributes; i++){
         bitset<M> * attrCov = new bitset<M>[nWords];
-        for (int j = 0; j < nWords; ++j) {
-            int currentindex = -1;
-            int* start = data + (ntransactions*i) + (M*j);
-            int* end = nullptr;
-            if (j != nWords - 1)
-                end = data + (ntransactions*i) + (M*j) + M;
-            else
-                end = data + (ntransactions*i) + ntransactions;
-            int dist = 0;
-
-            auto itr = find(start, end, 1);
-            while (itr != end && start < end) {
-                dist = distance(start, itr);
-                currentindex += 1 + dist;
-                attrCov[nWords-(j+1)].set(currentindex);
-                start += (dist + 1);
-                itr = find(start, end, 1);
-            }
-        }
+        packColumn(data + (ntransactions*i), ntransactions, 1, attrCov);
         b[i] = attrCov;
         //cout << "attr : " << i << " word = " << attrCov->to_string() << endl;
     }
 
 
+    // with several targets, the classes of the targets are distinct and the class cover gathers the columns
     if (target){
+        c = new bitset<M> *[nclasses];
         for (int i = 0; i < nclasses; i++){
             bitset<M> * classCov = new bitset<M>[nWords];
-            for (int j = 0; j < nWords; ++j) {
-                int currentindex = -1;
-                int* start = target + (M*j);
-                int* end = nullptr;
-                if (j != nWords - 1)
-                    end = target + (M*j) + M;
-                else
-                    end = target + ntransactions;
-                int dist = 0;
-
-                auto itr = find(start, end, i);
-                while (itr != end && start < end) {
-                    dist = distance(start, itr);
-                    currentindex += 1 + dist;
-                    classCov[nWords-(j+1)].set(currentindex);
-                    start += (dist + 1);
-                    itr = find(start, end, i);
-                }
-            }
+            for (int t = 0; t < ntargets; ++t) packColumn(target + ntransactions * t, ntransactions, i, classCov);
             c[i] = classCov;
         }
     }
@@ -66,8 +32,49 @@ DataManager::DataManager(Supports supports, int ntransactions, int nattributes,
         c = nullptr;
 
 
+    makeCurrent();
+}
+
+void DataManager::makeCurrent() const {
     ::nattributes = nattributes;
-    ::nclasses = nclasses;
+    ::nclasses = (nclasses == 1) ? 2 : nclasses;
+}
+
+void DataManager::packColumn(const int *column, int ntransactions, int value, bitset<M> *words) {
+    int nWords = (int)ceil((float)ntransactions/M);
+    for (int j = 0; j < nWords; ++j) {
+        const int* start = column + (M*j);
+        int size = (j != nWords - 1) ? M : ntransactions - M*j;
+        // built without branch, one bit per transaction
+        unsigned long long bits = 0;
+        for (int k = 0; k < size; ++k) bits |= (unsigned long long)(start[k] == value) << k;
+        words[nWords-(j+1)] |= bitset<M>(bits);
+    }
+}
+
+void DataManager::addTransactions(const int *data, const int *target, int n) {
+    if (c) for (int k = 0; k < n; ++k)
+        if (target[k] < 0 || target[k] >= nclasses) throw invalid_argument("The class of a new transaction is unknown");
+    int total = ntransactions + n;
+    int totalWords = (int)ceil((float)total/M);
+    // the words of the old transactions keep their index from the end of the array and the new bits are set
+    auto grow = [&](bitset<M> *&words, const int *column, int value) {
+        bitset<M> *grown = new bitset<M>[totalWords];
+        copy(words, words + nWords, grown + (totalWords - nWords));
+        for (int k = 0; k < n; ++k) {
+            int tid = ntransactions + k;
+            if (column[k] == value) grown[totalWords - (tid / M + 1)].set(tid % M);
+        }
+        delete[] words;
+        words = grown;
+    };
+    for (int i = 0; i < nattributes; ++i) grow(b[i], data + n * i, 1);
+    if (c) {
+        for (int j = 0; j < ((nclasses == 1) ? 2 : nclasses); ++j) grow(c[j], target, j);
+        for (int k = 0; k < n; ++k) supports[target[k]] += 1;
+    }
+    ntransactions = total;
+    nWords = totalWords;
 }
 
 bitset<M>* DataManager::getAttributeCover(int attr) {
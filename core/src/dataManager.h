@@ -18,20 +18,45 @@ class DataManager {
 public:
     int nWords;
 
-    DataManager(Supports supports, int ntransactions, int nattributes, int nclasses, int *b, int *c);
+    /**
+     * @param c - the class of each transaction. With several targets, the ntargets columns of ntransactions classes
+     * are stored one after the other and each column uses its own classes
+     */
+    DataManager(Supports supports, int ntransactions, int nattributes, int nclasses, int *b, int *c, int ntargets = 1);
 
     ~DataManager(){
         for (int i = 0; i < nattributes; ++i) {
             delete[] b[i];
         }
         delete[]b;
-        for (int j = 0; j < nclasses; ++j) {
-            delete[] c[j];
+        if (c) {
+            for (int j = 0; j < nclasses; ++j) {
+                delete[] c[j];
+            }
+            delete[]c;
         }
-        delete[]c;
         // deleteSupports(supports);
     }
 
+    /**
+     * packColumn - set the bits of the transactions of a column having a given value. As in the covers, the word j of
+     * the transactions is stored at index nWords-(j+1) and the bits already set in words are kept
+     * @param column - the values of the ntransactions transactions
+     * @param value - the value to select
+     * @param words - the ceil(ntransactions/M) words receiving the bits
+     */
+    static void packColumn(const int *column, int ntransactions, int value, bitset<M> *words);
+
+    /**
+     * addTransactions - append transactions to the packed data. The words of the transactions already packed are
+     * moved to keep the order of the covers and only the new transactions are packed. The supports given to the
+     * constructor are updated in place. Only a single target is supported
+     * @param data - the values of the features of the new transactions, column by column
+     * @param target - the class of each new transaction
+     * @param n - the number of new transactions
+     */
+    void addTransactions(const int *data, const int *target, int n);
+
     bitset<M> * getAttributeCover(int attr);
 
     bitset<M> * getClassCover(int clas);
@@ -48,6 +73,17 @@ public:
     /// get array of support of each class
     Supports getSupports () const { return supports; }
 
+    /// whether the transactions have classes, i.e. the class covers exist
+    bool hasClasses () const { return c != nullptr; }
+
+    /**
+     * makeCurrent - make the numbers of attributes and of classes of the data those of the searches of the calling
+     * thread (the thread-local globals nattributes and nclasses). The constructor does it for the thread creating the
+     * data manager; a search run in another thread, or after the data manager of another search was created in the
+     * same thread, must do it before using the data
+     */
+    void makeCurrent() const;
+
 private:
     bitset<M> **b; /// matrix of data
     bitset<M> **c; /// vector of target
@@ -55,7 +55,8 @@ TrieNode* computeDepthTwo(RCover* cover,
     // infeasible case. Avoid computing useless solution
     if (ub <= lb){
         node->data = query->initData(cover); // no need to update the error
-        if (verbose) cout << "infeasible case. ub = " << ub << " lb = " << lb << endl;
+        query->stats.prunedInfeasible += 1;
+        DL85_TRACE_EVENT("depth two infeasible", "lb", lb, "ub", ub);
         return node;
     }
 //    cout << "fifi" << endl;
@@ -65,13 +66,7 @@ TrieNode* computeDepthTwo(RCover* cover,
     ub = FLT_MAX;
 
     //count the number of call to this function for stats
-    ncall += 1;
-    //initialize the timer to count the time spent in this function
-    auto start = high_resolution_clock::now();
-
-    //local variable to make the function verbose or not. Can be improved :-)
-    bool local_verbose = verbose;
-//    if (last_added == 64) local_verbose = true;
+    query->stats.depthTwoCalls += 1;
 
     // get the support and the support per class of the root node
     Supports root_sup_clas = copySupports(cover->getSupportPerClass());
@@ -92,36 +87,38 @@ TrieNode* computeDepthTwo(RCover* cover,
     auto **sups_sc = new Supports *[attr.size()];
     // matrix for support. In fact, for weighted examples problems, the sum of "support per class" is not equal to "support"
     auto **sups = new Support* [attr.size()];
-    for (int l = 0; l < attr.size(); ++l) {
-        // memory allocation
-        sups_sc[l] = new Supports[attr.size()];
-        sups[l] = new Support[attr.size()];
-
-        // compute values for first level of the tree
-//        cout << "item : " << attr[l] << " ";
-        cover->intersect(attr[l]);
-        sups_sc[l][l] = copySupports(cover->getSupportPerClass());
-        sups[l][l] = cover->getSupport();
-
-        // compute value for second level
-        for (int i = l + 1; i < attr.size(); ++i) {
-//            cout << "\titem_fils : " << attr[i] << " ";
-            pair<Supports, Support> p = cover->temporaryIntersect(attr[i]);
-            sups_sc[l][i] = p.first;
-            sups[l][i] = p.second;
+    {
+        DL85_TRACE_SCOPE("depth two counting");
+        for (int l = 0; l < attr.size(); ++l) {
+            // memory allocation
+            sups_sc[l] = new Supports[attr.size()];
+            sups[l] = new Support[attr.size()];
+
+            // compute values for first level of the tree
+            cover->intersect(attr[l]);
+            sups_sc[l][l] = copySupports(cover->getSupportPerClass());
+            sups[l][l] = cover->getSupport();
+
+            // compute value for second level
+            for (int i = l + 1; i < attr.size(); ++i) {
+                pair<Supports, Support> p = cover->temporaryIntersect(attr[i]);
+                sups_sc[l][i] = p.first;
+                sups[l][i] = p.second;
+            }
+            // backtrack to recover the cover state
+            cover->backtrack();
         }
-        // backtrack to recover the cover state
-        cover->backtrack();
     }
     auto stop_comp = high_resolution_clock::now();
-    comptime += duration<double>(stop_comp - start_comp).count();
+    query->stats.depthTwoCountTime += duration<double>(stop_comp - start_comp).count();
 
+    DL85_TRACE_SCOPE("depth two selection");
     auto* best_tree = new TreeTwo();
     //TreeTwo* feat_best_tree;
 
     // find the best tree for each feature
     for (int i = 0; i < attr.size(); ++i) {
-        if (local_verbose) cout << "root test: " << attr[i] << endl;
+        DL85_TRACE_EVENT("depth two root", "attribute", attr[i]);
         //cout << "beeest " << best_tree->root_data->error << endl;
 
         // best tree for the current feature
@@ -143,7 +140,7 @@ TrieNode* computeDepthTwo(RCover* cover,
         //feature to left
         // the feature cannot be root since its two children will not fullfill the minsup constraint
         if (igs < query->minsup || ids < query->minsup) {
-            if (local_verbose) cout << "root impossible de splitter...on backtrack" << endl;
+            DL85_TRACE_EVENT("depth two root not frequent", "attribute", attr[i]);
             delete feat_best_tree;
             deleteSupports(igsc);
             continue;
@@ -157,12 +154,10 @@ TrieNode* computeDepthTwo(RCover* cover,
             LeafInfo ev = query->computeLeafInfo(igsc);
             feat_best_tree->root_data->left->error = ev.error;
             feat_best_tree->root_data->left->test = ev.maxclass;
-            if (local_verbose)
-                cout << "root gauche ne peut théoriquement spliter; donc feuille. erreur gauche = " << feat_best_tree->root_data->left->error << " on backtrack" << endl;
+            DL85_TRACE_EVENT("depth two left leaf", "error", feat_best_tree->root_data->left->error);
         }
         // the root node can theorically be split at left
         else {
-            if (local_verbose) cout << "root gauche peut théoriquement spliter. Creusons plus..." << endl;
 //            cout << "beeest " << best_tree->root_data->error << endl;
             // at worst it can't in practice and error will be considered as leaf node
             // so the error is initialized at this case
@@ -174,11 +169,7 @@ TrieNode* computeDepthTwo(RCover* cover,
             if (!floatEqual(ev.error, lb)) {
                 Error tmp = feat_best_tree->root_data->left->error;
                 for (int j = 0; j < attr.size(); ++j) {
-                    if (local_verbose) cout << "left test: " << attr[j] << endl;
-                    if (attr[i] == attr[j]) {
-                        if (local_verbose) cout << "left pareil que le parent ou non sup...on essaie un autre left" << endl;
-                        continue;
-                    }
+                    if (attr[i] == attr[j]) continue;
                     Supports jdsc = sups_sc[j][j], idjdsc = sups_sc[min(i, j)][max(i, j)], igjdsc = newSupports();
                     subSupports(jdsc, idjdsc, igjdsc);
                     Support jds = sups[j][j]; // Support jds = sumSupports(jdsc);
@@ -188,16 +179,12 @@ TrieNode* computeDepthTwo(RCover* cover,
 
                     // the root node can in practice be split into two children
                     if (igjgs >= query->minsup && igjds >= query->minsup) {
-                        if (local_verbose) cout << "le left testé peut splitter. on le regarde" << endl;
 //                        cout << "beeest " << best_tree->root_data->error << endl;
 
                         LeafInfo ev2 = query->computeLeafInfo(igjdsc);
-                        if (local_verbose) cout << "le left a droite produit une erreur de " << ev2.error << endl;
 //                        cout << "beeest " << best_tree->root_data->error << endl;
 
                         if (ev2.error >= min(best_tree->root_data->error, feat_best_tree->root_data->left->error)) {
-                            if (local_verbose)
-                                cout << "l'erreur gauche du left montre rien de bon. best root: " << best_tree->root_data->error << " best left: " << feat_best_tree->root_data->left->error << " Un autre left..." << endl;
                             deleteSupports(igjdsc);
                             continue;
                         }
@@ -205,13 +192,11 @@ TrieNode* computeDepthTwo(RCover* cover,
                         Supports igjgsc = newSupports();
                         subSupports(igsc, igjdsc, igjgsc);
                         LeafInfo ev1 = query->computeLeafInfo(igjgsc);
-                        if (local_verbose) cout << "le left a gauche produit une erreur de " << ev1.error << endl;
 //                        cout << "beeest " << best_tree->root_data->error << endl;
 
                         if (ev1.error + ev2.error < min(best_tree->root_data->error, feat_best_tree->root_data->left->error)) {
                             feat_best_tree->root_data->left->error = ev1.error + ev2.error;
-                            if (local_verbose)
-                                cout << "ce left ci donne une meilleure erreur que les précédents left: " << feat_best_tree->root_data->left->error << endl;
+                            DL85_TRACE_EVENT("depth two better left", "attribute", attr[j], "error", feat_best_tree->root_data->left->error);
                             if (!feat_best_tree->root_data->left->left){
                                 feat_best_tree->root_data->left->left = new QueryData_Best();
                                 feat_best_tree->root_data->left->right = new QueryData_Best();
@@ -231,41 +216,32 @@ TrieNode* computeDepthTwo(RCover* cover,
                                 deleteSupports(igjgsc);
                                 break;
                             }
-                        } else {
-                            if (local_verbose)
-                                cout << "l'erreur du left = " << ev1.error + ev2.error << " n'ameliore pas l'existant. Un autre left..." << endl;
                         }
 //                        cout << "beeest " << best_tree->root_data->error << endl;
                         deleteSupports(igjgsc);
-                    } else if (local_verbose) cout << "le left testé ne peut splitter en pratique...un autre left!!!" << endl;
+                    }
                     deleteSupports(igjdsc);
                 }
                 if (floatEqual(feat_best_tree->root_data->left->error, tmp)){
                     // do not use the best tree error but the feat left leaferror
                     feat_best_tree->root_data->left->error = feat_best_tree->root_data->left->leafError;
-                    if (local_verbose) cout << "aucun left n'a su splitter. on garde le root gauche comme leaf avec erreur: " << feat_best_tree->root_data->left->error << endl;
+                    DL85_TRACE_EVENT("depth two left leaf", "error", feat_best_tree->root_data->left->error);
                 }
-            } else {
-                if (local_verbose)
-                    cout << "l'erreur du root gauche est minimale. on garde le root gauche comme leaf avec erreur: " << feat_best_tree->root_data->left->error << endl;
-            }
+            } else DL85_TRACE_EVENT("depth two left leaf", "error", feat_best_tree->root_data->left->error);
         }
 
 
         //feature to right
 //        cout << "bestoor si error " << best_tree->root_data->error << endl;
         if (feat_best_tree->root_data->left->error < best_tree->root_data->error) {
-            if (local_verbose) cout << "vu l'erreur du root gauche et du left. on peut tenter quelque chose à droite" << endl;
 
             // the feature at root cannot be split at right. It is then a leaf node
             if (ids < 2 * query->minsup) {
                 LeafInfo ev = query->computeLeafInfo(idsc);
                 feat_best_tree->root_data->right->error = ev.error;
                 feat_best_tree->root_data->right->test = ev.maxclass;
-                if (local_verbose)
-                    cout << "root droite ne peut théoriquement spliter; donc feuille. erreur droite = " << feat_best_tree->root_data->right->error << " on backtrack" << endl;
+                DL85_TRACE_EVENT("depth two right leaf", "error", feat_best_tree->root_data->right->error);
             } else {
-                if (local_verbose) cout << "root droite peut théoriquement spliter. Creusons plus..." << endl;
                 // at worst it can't in practice and error will be considered as leaf node
                 // so the error is initialized at this case
                 LeafInfo ev = query->computeLeafInfo(idsc);
@@ -278,12 +254,7 @@ TrieNode* computeDepthTwo(RCover* cover,
 
                 if (!floatEqual(ev.error, lb)) {
                     for (int j = 0; j < attr.size(); ++j) {
-                        if (local_verbose) cout << "right test: " << attr[j] << endl;
-                        if (attr[i] == attr[j]) {
-                            if (local_verbose)
-                                cout << "right pareil que le parent ou non sup...on essaie un autre right" << endl;
-                            continue;
-                        }
+                        if (attr[i] == attr[j]) continue;
 
                         Supports idjdsc = sups_sc[min(i, j)][max(i, j)], idjgsc = newSupports();
                         subSupports(idsc, idjdsc, idjgsc);
@@ -292,21 +263,17 @@ TrieNode* computeDepthTwo(RCover* cover,
 
                         // the root node can in practice be split into two children
                         if (idjgs >= query->minsup && idjds >= query->minsup) {
-                            if (local_verbose) cout << "le right testé peut splitter. on le regarde" << endl;
                             LeafInfo ev1 = query->computeLeafInfo(idjgsc);
-                            if (local_verbose) cout << "le right a gauche produit une erreur de " << ev1.error << endl;
 
                             if (ev1.error >= min(remainingError, feat_best_tree->root_data->right->error)) {
-                                if (local_verbose) cout << "l'erreur gauche du right montre rien de bon. Un autre right..." << endl;
                                 deleteSupports(idjgsc);
                                 continue;
                             }
 
                             LeafInfo ev2 = query->computeLeafInfo(idjdsc);
-                            if (local_verbose) cout << "le right a droite produit une erreur de " << ev2.error << endl;
                             if (ev1.error + ev2.error < min(remainingError, feat_best_tree->root_data->right->error)) {
                                 feat_best_tree->root_data->right->error = ev1.error + ev2.error;
-                                if (local_verbose) cout << "ce right ci donne une meilleure erreur que les précédents right: " << feat_best_tree->root_data->right->error << endl;
+                                DL85_TRACE_EVENT("depth two better right", "attribute", attr[j], "error", feat_best_tree->root_data->right->error);
                                 if (!feat_best_tree->root_data->right->left){
                                     feat_best_tree->root_data->right->left = new QueryData_Best();
                                     feat_best_tree->root_data->right->right = new QueryData_Best();
@@ -325,18 +292,16 @@ TrieNode* computeDepthTwo(RCover* cover,
                                     deleteSupports(idjgsc);
                                     break;
                                 }
-                            } else {
-                                if (local_verbose) cout << "l'erreur du right = " << ev1.error + ev2.error << " n'ameliore pas l'existant. Un autre right..." << endl;
                             }
-                        } else if (local_verbose) cout << "le right testé ne peut splitter...un autre right!!!" << endl;
+                        }
                         deleteSupports(idjgsc);
                     }
                     if (floatEqual(feat_best_tree->root_data->right->error, tmp)){
                         // in this case, do not use the remaining as error but leaferror
                         feat_best_tree->root_data->right->error = feat_best_tree->root_data->right->leafError;
-                        if (local_verbose) cout << "aucun right n'a su splitter. on garde le root droite comme leaf avec erreur: " << feat_best_tree->root_data->right->error << endl;
+                        DL85_TRACE_EVENT("depth two right leaf", "error", feat_best_tree->root_data->right->error);
                     }
-                } else if (local_verbose) cout << "l'erreur du root droite est minimale. on garde le root droite comme leaf avec erreur: " << feat_best_tree->root_data->right->error << endl;
+                } else DL85_TRACE_EVENT("depth two right leaf", "error", feat_best_tree->root_data->right->error);
             }
 
             if (feat_best_tree->root_data->left->error + feat_best_tree->root_data->right->error < best_tree->root_data->error) {
@@ -346,11 +311,8 @@ TrieNode* computeDepthTwo(RCover* cover,
                 //best_tree = feat_best_tree;
                 //cout << "replaccc" << endl;
                 best_tree->replaceTree(feat_best_tree);
-                if (local_verbose) cout << "ce triple (root, left, right) ci donne une meilleure erreur que les précédents triplets: " << best_tree->root_data->error << " " << best_tree->root_data->test << endl;
-            } else {
-                delete feat_best_tree;
-                if (local_verbose) cout << "cet arbre n'est pas mieux que le meilleur jusque là." << endl;
-            }
+                DL85_TRACE_EVENT("depth two better tree", "attribute", best_tree->root_data->test, "error", best_tree->root_data->error);
+            } else delete feat_best_tree;
         }
         else delete feat_best_tree;
         deleteSupports(igsc);
@@ -368,11 +330,6 @@ TrieNode* computeDepthTwo(RCover* cover,
     delete [] sups_sc;
     delete [] sups;
     deleteSupports(root_sup_clas);
-    if (local_verbose && best_tree->root_data && best_tree->root_data->left && best_tree->root_data->right) cout << "root: " << best_tree->root_data->test << " left: " << best_tree->root_data->left->test << " right: " << best_tree->root_data->right->test << endl;
-//    if (local_verbose) cout << "le1: " << best_tree->root_data->left->left->error << " le2: " << best_tree->root_data->left->right->error << " re1: " << best_tree->root_data->right->left->error << " re2: " << best_tree->root_data->right->right->error << endl;
-//    if (local_verbose) cout << "ble: " << best_tree->root_data->left->error << " bre: " << best_tree->root_data->right->error << " broe: " << best_tree->root_data->error << endl;
-//    if (local_verbose) cout << "lc1: " << best_tree->root_data->left->left->test << " lc2: " << best_tree->root_data->left->right->test << " rc1: " << best_tree->root_data->right->left->test << " rc2: " << best_tree->root_data->right->right->test << endl;
-//    if (local_verbose) cout << "blc: " << best_tree->root_data->left->test << " brc: " << best_tree->root_data->right->test << endl;
 
     if (best_tree->root_data->test != -1) {
         if (best_tree->root_data->size == 3 && best_tree->root_data->left->test == best_tree->root_data->right->test && floatEqual(best_tree->root_data->leafError, best_tree->root_data->left->error + best_tree->root_data->right->error)) {
@@ -385,8 +342,8 @@ TrieNode* computeDepthTwo(RCover* cover,
             best_tree->root_data->right = nullptr;
             node->data = (QueryData *)best_tree->root_data;
             auto stop = high_resolution_clock::now();
-            spectime += duration<double>(stop - stop_comp).count();
-            if (verbose) cout << "best twotree error = " << to_string(best_tree->root_data->error) << endl;
+            query->stats.depthTwoSelectTime += duration<double>(stop - stop_comp).count();
+            DL85_TRACE_EVENT("depth two tree", "error", best_tree->root_data->error);
             return node;
         }
 
@@ -394,9 +351,9 @@ TrieNode* computeDepthTwo(RCover* cover,
         setItem((QueryData_Best *) node->data, itemset, trie);
 
         auto stop = high_resolution_clock::now();
-        spectime += duration<double>(stop - stop_comp).count();
+        query->stats.depthTwoSelectTime += duration<double>(stop - stop_comp).count();
 
-        if (verbose) cout << "best twotree error = " << to_string(best_tree->root_data->error) << endl;
+        DL85_TRACE_EVENT("depth two tree", "error", ((QDB) node->data)->error);
         return node;
     } else {
         //error not lower than ub
@@ -407,8 +364,8 @@ TrieNode* computeDepthTwo(RCover* cover,
         ((QueryData_Best *) node->data)->leafError = ev.error;
         ((QueryData_Best *) node->data)->test = ev.maxclass;
         auto stop = high_resolution_clock::now();
-        spectime += duration<double>(stop - stop_comp).count();
-        if (verbose) cout << "best twotree error = " << to_string(best_tree->root_data->error) << endl;
+        query->stats.depthTwoSelectTime += duration<double>(stop - stop_comp).count();
+        DL85_TRACE_EVENT("depth two tree", "error", ((QDB) node->data)->error);
         return node;
     }
 
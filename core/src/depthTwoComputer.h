@@ -8,6 +8,7 @@
 #include "trie.h"
 #include "query.h"
 #include "query_best.h"
+#include "tracing.h"
 #include <chrono>
 #include <utility>
 
@@ -4,6 +4,30 @@ using namespace std::chrono;
 
 //bool verbose = false;
 
+// attaches the recorder of the operations to the cover and to the trie of a search. It is detached and closed by close()
+// or at the destruction, so that the cover and the trie never keep a deleted trace when the search throws
+class TraceAttachment {
+public:
+    TraceAttachment(SearchTrace *trace, RCover *cover, Trie *trie) : trace(trace), cover(cover), trie(trie) {
+        cover->trace = trie->trace = trace;
+    }
+
+    ~TraceAttachment() { close(); }
+
+    void close() {
+        if (!cover) return;
+        cover->trace = trie->trace = nullptr;
+        cover = nullptr;
+        trie = nullptr;
+        trace.reset();
+    }
+
+private:
+    unique_ptr<SearchTrace> trace;
+    RCover *cover;
+    Trie *trie;
+};
+
 string search(Supports supports,
               Transaction ntransactions,
               Attribute nattributes,
@@ -15,7 +39,7 @@ string search(Supports supports,
               float maxError,
               bool stopAfterError,
               function<vector<float>(RCover *)> tids_error_class_callback,
-              function<vector<float>(RCover *)> supports_error_class_callback,
+              function<void(Supports, float *)> supports_error_class_callback,
               function<float(RCover *)> tids_error_callback,
               float* in_weights,
               bool tids_error_class_is_null,
@@ -25,22 +49,107 @@ string search(Supports supports,
               bool infoAsc,
               bool repeatSort,
               int timeLimit,
-              bool verbose_param) {
+              bool verbose_param,
+              NativeError *native_error,
+              function<vector<float>(LeafBatch *)> batch_error_class_callback,
+              bool batch_error_class_is_null,
+              bool batch_on_supports,
+              int leafCacheSize,
+              float *reg_target,
+              int regCriterion,
+              int nRegTargets,
+              float *cost_matrix,
+              float errorDecreaseBound,
+              int nTargets,
+              float *target_weights,
+              Tree *out_tree,
+              Bool *root_mask,
+              const char *trace_file,
+              const char *tracing_file) {
 
     //as cython can't set null to function, we use a flag to set the appropriated functions to null in c++
     function<vector<float>(RCover *)> *tids_error_class_callback_pointer = &tids_error_class_callback;
     if (tids_error_class_is_null) tids_error_class_callback_pointer = nullptr;
 
-    function<vector<float>(RCover *)> *supports_error_class_callback_pointer = &supports_error_class_callback;
+    function<void(Supports, float *)> *supports_error_class_callback_pointer = &supports_error_class_callback;
     if (supports_error_class_is_null) supports_error_class_callback_pointer = nullptr;
 
     function<float(RCover *)> *tids_error_callback_pointer = &tids_error_callback;
     if (tids_error_is_null) tids_error_callback_pointer = nullptr;
 
+    function<vector<float>(LeafBatch *)> *batch_error_class_callback_pointer = &batch_error_class_callback;
+    if (batch_error_class_is_null) batch_error_class_callback_pointer = nullptr;
+
     verbose = verbose_param;
     string out = "";
 
-    auto *dataReader = new DataManager(supports, ntransactions, nattributes, nclasses, data, target);
+    if (reg_target && nRegTargets > 1 && regCriterion != MSE_CRITERION)
+        throw invalid_argument("Only the squared error can be used with several regression targets");
+
+    // the lower bounds of the search assume that the cost of a leaf never decreases when examples are added to it
+    if (cost_matrix && !reg_target)
+        for (int i = 0; i < nclasses * nclasses; ++i)
+            if (!(cost_matrix[i] >= 0)) throw invalid_argument("The costs of the cost matrix must be positive or zero");
+
+    // the regression covers store the weight, the sums and the sum of squares of the targets instead of the supports
+    // per class. The statistics of the whole dataset replace the supports given in parameter
+    vector<SupportClass> reg_supports(nstats(nRegTargets), 0);
+    if (reg_target) {
+        nclasses = nstats(nRegTargets);
+        for (int i = 0; i < ntransactions; ++i) {
+            if (root_mask && !root_mask[i]) continue;
+            float w = (in_weights) ? in_weights[i] : 1;
+            reg_supports[0] += w;
+            for (int f = 0; f < nRegTargets; ++f) {
+                float y = reg_target[i * nRegTargets + f];
+                reg_supports[f + 1] += w * y;
+                reg_supports[nRegTargets + 1] += w * y * y;
+            }
+        }
+        supports = reg_supports.data();
+        target = nullptr;
+    }
+
+    // the classes of the targets are stored side by side: the class k of the target t is the class
+    // target_offsets[t] + k of the data manager. Each target has two classes at least, so that a class cover is never
+    // deduced from the other one as in the binary case
+    vector<int> target_offsets(1, 0);
+    vector<Class> target_classes;
+    vector<SupportClass> target_supports;
+    if (target && nTargets > 1) {
+        if (cost_matrix) throw invalid_argument("The cost matrix cannot be used with several targets");
+        // Query_MultiTarget only computes the weighted misclassification of the targets
+        if (tids_error_class_callback_pointer || supports_error_class_callback_pointer || tids_error_callback_pointer ||
+            batch_error_class_callback_pointer || native_error)
+            throw invalid_argument("The error functions and the error plugins cannot be used with several targets");
+        for (int t = 0; t < nTargets; ++t) {
+            Class *column = target + ntransactions * t;
+            Class tclasses = max(2, *max_element(column, column + ntransactions) + 1);
+            target_offsets.push_back(target_offsets.back() + tclasses);
+        }
+        nclasses = target_offsets.back();
+        target_classes.resize(ntransactions * nTargets);
+        target_supports.assign(nclasses, 0);
+        for (int t = 0; t < nTargets; ++t)
+            for (int i = 0; i < ntransactions; ++i) {
+                Class c = target_offsets[t] + target[ntransactions * t + i];
+                target_classes[ntransactions * t + i] = c;
+                if (!root_mask || root_mask[i]) ++target_supports[c];
+            }
+        supports = target_supports.data();
+        target = target_classes.data();
+    }
+
+    // the supports of a single target are those of the transactions of the root cover
+    vector<SupportClass> mask_supports;
+    if (root_mask && target && nTargets == 1) {
+        mask_supports.assign(nclasses, 0);
+        for (int i = 0; i < ntransactions; ++i) if (root_mask[i]) ++mask_supports[target[i]];
+        supports = mask_supports.data();
+    }
+
+    auto *dataReader = new DataManager(supports, ntransactions, nattributes, nclasses, data, target,
+                                       (target) ? nTargets : 1);
 
 
     vector<float> weights;
@@ -49,29 +158,75 @@ string search(Supports supports,
     // create an empty trie to store the search space
     Trie *trie = new Trie;
 
-    Query *query = new Query_TotalFreq(minsup, maxdepth, trie, dataReader, timeLimit,
-                                       tids_error_class_callback_pointer, supports_error_class_callback_pointer,
-                                       tids_error_callback_pointer, maxError, stopAfterError);
+    // memo table of the python error function results
+    bool python_error = tids_error_class_callback_pointer || supports_error_class_callback_pointer ||
+                        tids_error_callback_pointer || batch_error_class_callback_pointer;
+    LeafCache *leaf_cache = (python_error && leafCacheSize > 0) ? new LeafCache(leafCacheSize) : nullptr;
+
+    // the dataset may have less classes than the data manager. The missing costs are the misclassification ones
+    vector<float> costs;
+    if (cost_matrix) {
+        costs.resize(::nclasses * ::nclasses);
+        for (int i = 0; i < ::nclasses; ++i)
+            for (int j = 0; j < ::nclasses; ++j)
+                costs[i * ::nclasses + j] = (i < nclasses && j < nclasses) ? cost_matrix[i * nclasses + j] : (i != j);
+    }
+
+    // init variables
+    // use the correct cover depending on the task and on whether a weight array is provided or not
+    RCover *cover;
+    if (reg_target) cover = new RCoverRegression(dataReader, reg_target, nRegTargets, (in_weights) ? &weights : nullptr); // regression cover
+    else if (in_weights) cover = new RCoverWeighted(dataReader, &weights); // weighted cover
+    else cover = new RCoverTotalFreq(dataReader); // non-weighted cover
+    // the operations of the search on the cover and on the trie are recorded when a trace file is given
+    TraceAttachment trace((trace_file) ? new SearchTrace(trace_file, dataReader, (in_weights) ? &weights : nullptr) : nullptr,
+                          cover, trie);
+    if (root_mask) {
+        vector<bitset<M>> mask(dataReader->nWords);
+        DataManager::packColumn(root_mask, ntransactions, 1, mask.data());
+        cover->restrictRoot(mask.data());
+    }
+
+    Query *query;
+    if (reg_target) query = new Query_Regression(minsup, maxdepth, trie, dataReader, timeLimit, (RCoverRegression *) cover,
+                                                 (RegressionCriterion) regCriterion, maxError, stopAfterError);
+    else if (nTargets > 1) query = new Query_MultiTarget(minsup, maxdepth, trie, dataReader, timeLimit, target_offsets,
+                                                         target_weights, maxError, stopAfterError);
+    else query = new Query_TotalFreq(minsup, maxdepth, trie, dataReader, timeLimit,
+                                     tids_error_class_callback_pointer, supports_error_class_callback_pointer,
+                                     tids_error_callback_pointer, maxError, stopAfterError, native_error,
+                                     batch_error_class_callback_pointer, batch_on_supports, leaf_cache,
+                                     (cost_matrix) ? costs.data() : nullptr, errorDecreaseBound);
 
     out = "TrainingDistribution: ";
     forEachClass(i) out += std::to_string(dataReader->getSupports()[i]) + " ";
     out += "\n";
     out = "(nItems, nTransactions) : ( " + to_string(dataReader->getNAttributes() * 2) + ", " + to_string(dataReader->getNTransactions()) + " )\n";
 
-    // init variables
-    // use the correct cover depending on whether a weight array is provided or not
-    RCover *cover;
-    if (in_weights) cover = new RCoverWeighted(dataReader, &weights); // weighted cover
-    else cover = new RCoverTotalFreq(dataReader); // non-weighted cover
-    auto lcm = new LcmPruned(cover, query, infoGain, infoAsc, repeatSort);
+    // the information gain heuristic needs classes
+    auto lcm = new LcmPruned(cover, query, infoGain && !reg_target && nTargets == 1, infoAsc, repeatSort);
     auto start_tree = high_resolution_clock::now();
-    ((LcmPruned *) lcm)->run(); // perform the search
+    {
+        // the events of the search are recorded in tracing_file, and written on the standard output when verbose
+        TracingSession tracing(tracing_file, verbose);
+        ((LcmPruned *) lcm)->run(); // perform the search
+    }
     auto stop_tree = high_resolution_clock::now();
+    trace.close();
     Tree *tree_out = new Tree();
-    query->printResult(tree_out); // build the tree model
+    query->printResult(tree_out, cover); // build the tree model
     tree_out->latSize = ((LcmPruned *) lcm)->latticesize;
     tree_out->searchRt = duration<double>(stop_tree - start_tree).count();
+    tree_out->stats = query->stats;
     out += tree_out->to_str();
+    // the leaf of each training transaction is found on the covers of the attributes already packed by the search
+    if (out_tree && !tree_out->feature.empty()) {
+        tree_out->transactionLeaf.resize(dataReader->getNTransactions());
+        TreePredictor(tree_out->feature.data(), tree_out->left.data(), tree_out->right.data(),
+                      (int) tree_out->feature.size()).predictLeaves(dataReader, tree_out->transactionLeaf.data());
+        ((Query_Best *) query)->printSupports(tree_out, cover);
+    }
+    if (out_tree) *out_tree = move(*tree_out);
 
 
     delete trie;
@@ -80,6 +235,7 @@ string search(Supports supports,
     delete cover;
     delete lcm;
     delete tree_out;
+    delete leaf_cache;
 
 //    auto stop = high_resolution_clock::now();
 //    cout << "Durée totale de l'algo : " << duration<double>(stop - start).count() << endl;
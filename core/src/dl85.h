@@ -14,13 +14,23 @@
 #include <vector>
 #include <utility>
 #include <functional>
+#include <memory>
 #include <chrono>
+#include <stdexcept>
 #include "globals.h"
 #include "dataManager.h"
 #include "rCoverTotalFreq.h"
 #include "rCoverWeighted.h"
+#include "rCoverRegression.h"
 #include "lcm_pruned.h"
 #include "query_totalfreq.h"
+#include "query_regression.h"
+#include "query_multitarget.h"
+#include "nativeError.h"
+#include "leafCache.h"
+#include "treePredictor.h"
+#include "searchTrace.h"
+#include "tracing.h"
 //#include "query_weighted.h"
 
 using namespace std;
@@ -37,7 +47,7 @@ using namespace std;
  * @param stopAfterError - boolean variable to state that the search must stop as soon as an error better than "maxError" is reached. Default value is false
  * @param iterative - boolean variable to express whether the search performed will be IDS or not; the default being DFS. Default value is false
  * @param tids_error_class_callback - a callback function from python taking transactions ID of a node as param and returning the error and the class of the node. Default value is null.
- * @param supports_error_class_callback - a callback function from python taking supports per class of a node as param and returning the error and the class of the node. Default value is null.
+ * @param supports_error_class_callback - a callback function from python taking supports per class of a node as param and writing the error, the class and optionally a lower bound of the error of the node in an output array. Default value is null.
  * @param tids_error_callback - a callback function from python taking transactions ID of a node as param and returning the error of the node. Default value is null.
  * @param tids_error_class_is_null - a flag caused by cython to handle whether tids_error_class_callback is null or not. Default is true
  * @param supports_error_class_is_null - a flag caused by cython to handle whether supports_error_class_callback is null or not. Default is true
@@ -51,6 +61,22 @@ using namespace std;
  * @param continuousMap - a value planned to handle continuous datasets. It is not used currently. Must be set to null
  * @param save - a value planned to handle continuous datasets. It is not used currently. Must be set to false
  * @param verbose_param - a boolean value to set whether the search must be verbose or not. Default value is false
+ * @param native_error - an error function implemented in C++ (e.g. loaded from a shared object with PluginError). It is used instead of the default error when it is not null. Default value is null
+ * @param batch_error_class_callback - a callback function from python taking a batch of leaves (the children of a node) as param and returning the error of each leaf followed by its class. Default value is null.
+ * @param batch_error_class_is_null - a flag caused by cython to handle whether batch_error_class_callback is null or not. Default is true
+ * @param batch_on_supports - whether the leaves of a batch are described by their supports per class or by their transactions ids. Default is false
+ * @param leafCacheSize - the maximum number of python error function results memorized to skip the calls on already evaluated covers. Default value 0 means that the results are not memorized
+ * @param reg_target - array of numerical targets of the dataset. When it is not null, a regression tree is learnt, target must be null and the error functions are ignored. Default value is null
+ * @param regCriterion - the error of the regression tree: 0 for the squared error, 1 for the absolute error (see RegressionCriterion). Default is 0
+ * @param cost_matrix - the cost of predicting each class for an example of each class, as a nclasses x nclasses array stored row by row (the row is the real class). When it is not null, the total cost of the leaves is minimized instead of the misclassification. Default value is null
+ * @param nRegTargets - the number of targets per transaction in reg_target, stored row by row. Several targets are used for the clustering, where the targets are the features used to compute the distances. Only the squared error supports several targets. Default is 1
+ * @param errorDecreaseBound - the highest decrease of the custom error of a leaf when a transaction of unit weight is removed from it. When it is positive, the similarity lower bound is used with the python or native non-additive errors. Default value 0 means that it is unknown
+ * @param nTargets - the number of class targets in target, stored one after the other. With several targets, a single tree predicting all of them is learnt and the error functions are ignored. Default is 1
+ * @param target_weights - the weight of the misclassification error of each target when there are several targets. Default value null means unit weights
+ * @param out_tree - when it is not null, it receives the tree found, including its flat arrays and the leaf of each transaction (see Tree). It avoids parsing the tree from the returned text. Default value is null
+ * @param root_mask - the ntransactions flags of the transactions searched (1) or left out (0), e.g. the training examples of a cross-validation fold. The others are removed from the root cover and from the supports, while the data stay packed once. Default value null means all the transactions
+ * @param trace_file - the file receiving the trace of the cover and cache operations of the search, to replay them with dl85_trace_replay (see SearchTrace). Default value null means that nothing is recorded
+ * @param tracing_file - the file receiving the events of the search (see tracing.h) in the Chrome trace event format, read by chrome://tracing and Perfetto. Default value null means the file given by the environment variable DL85_TRACING_FILE, if any. The events are also written on the standard output when verbose_param is true. Nothing is recorded when the library is built without DL85_TRACING
  * @return a string representing a serialized form of the found tree is returned
  */
 string search(Supports supports,
@@ -67,9 +93,9 @@ string search(Supports supports,
               //get a pointer on cover as param and return a vector of float. Due to iterator behaviour of RCover
               // object and the wrapping done in cython, this pointer in python is seen as a list of tids in the cover
               function<vector<float>(RCover *)> tids_error_class_callback = nullptr,
-              //get a pointer on cover as param and return a vector of float. Due to iterator behaviour of RCover object
-              // and the wrapping done in cython, this pointer in python is seen as a list of support per class of the cover
-              function<vector<float>(RCover *)> supports_error_class_callback = nullptr,
+              //get the supports per class of a node as param and write its error and its class in the output array. The
+              // wrapping done in cython exposes the supports in python as a numpy array reused between the calls
+              function<void(Supports, float *)> supports_error_class_callback = nullptr,
               //get a pointer on cover as param and return a float. Due to iterator behaviour of RCover object and the
               // wrapping done in cython, this pointer in python is seen as a list of tids in the cover
               function<float(RCover *)> tids_error_callback = nullptr,
@@ -81,6 +107,24 @@ string search(Supports supports,
               bool infoAsc = true,
               bool repeatSort = false,
               int timeLimit = 0,
-              bool verbose_param = false);
+              bool verbose_param = false,
+              NativeError *native_error = nullptr,
+              //get a pointer on a batch of leaves and return a vector of float. The wrapping done in cython exposes
+              // the batch in python as numpy arrays of tids in CSR-like layout or as a 2-D array of supports per class
+              function<vector<float>(LeafBatch *)> batch_error_class_callback = nullptr,
+              bool batch_error_class_is_null = true,
+              bool batch_on_supports = false,
+              int leafCacheSize = 0,
+              float *reg_target = nullptr,
+              int regCriterion = MSE_CRITERION,
+              int nRegTargets = 1,
+              float *cost_matrix = nullptr,
+              float errorDecreaseBound = 0,
+              int nTargets = 1,
+              float *target_weights = nullptr,
+              Tree *out_tree = nullptr,
+              Bool *root_mask = nullptr,
+              const char *trace_file = nullptr,
+              const char *tracing_file = nullptr);
 
 #endif //DL85_DL85_H
@@ -0,0 +1,123 @@
+#include "forest.h"
+#include "rCoverTotalFreq.h"
+#include "rCoverWeighted.h"
+#include "rCoverRegression.h"
+#include "lcm_pruned.h"
+#include "query_totalfreq.h"
+#include "query_regression.h"
+#include <random>
+#include <exception>
+
+// learn the tree of one sample on the shared data manager
+static void searchTree(DataManager *dm, const float *sample_weights, const Bool *sample_mask, float *reg_target,
+                       const vector<Attribute> &features, int maxdepth, int minsup, int timeLimit, Tree *tree) {
+    int ntransactions = dm->getNTransactions();
+    vector<float> weights;
+    if (sample_weights) weights.assign(sample_weights, sample_weights + ntransactions);
+
+    RCover *cover;
+    if (reg_target) cover = new RCoverRegression(dm, reg_target, 1, (sample_weights) ? &weights : nullptr);
+    else if (sample_weights) cover = new RCoverWeighted(dm, &weights);
+    else cover = new RCoverTotalFreq(dm);
+
+    // the transactions out of the sample are removed from the root cover
+    if (sample_mask || sample_weights) {
+        vector<bitset<M>> mask(dm->nWords, (sample_mask) ? bitset<M>() : bitset<M>().set());
+        if (sample_mask) DataManager::packColumn(sample_mask, ntransactions, 1, mask.data());
+        if (sample_weights)
+            for (int i = 0; i < ntransactions; ++i)
+                if (weights[i] <= 0) mask[dm->nWords - (i / M + 1)].reset(i % M);
+        cover->restrictRoot(mask.data());
+    }
+
+    Trie *trie = new Trie;
+    Query *query;
+    if (reg_target) query = new Query_Regression(minsup, maxdepth, trie, dm, timeLimit, (RCoverRegression *) cover);
+    else query = new Query_TotalFreq(minsup, maxdepth, trie, dm, timeLimit);
+
+    auto lcm = new LcmPruned(cover, query, false, false, false);
+    lcm->attributes = features;
+    lcm->run();
+    query->printResult(tree, cover);
+    tree->stats = query->stats;
+
+    delete lcm;
+    delete query;
+    delete trie;
+    delete cover;
+}
+
+void searchForest(Supports supports,
+                  int ntransactions,
+                  int nattributes,
+                  int nclasses,
+                  Bool *data,
+                  Class *target,
+                  int ntrees,
+                  const float *sample_weights,
+                  const Bool *sample_masks,
+                  int max_features,
+                  unsigned seed,
+                  int maxdepth,
+                  int minsup,
+                  int timeLimit,
+                  float *reg_target,
+                  bool use_threads,
+                  Forest *forest) {
+    if (max_features < 0 || max_features > nattributes)
+        throw invalid_argument("The number of features per tree must be between 0 and " + to_string(nattributes));
+
+    // the regression covers store the weight, the sum and the sum of squares of the target instead of the supports
+    vector<SupportClass> reg_supports(nstats(1), 0);
+    if (reg_target) {
+        nclasses = nstats(1);
+        supports = reg_supports.data();
+        target = nullptr;
+    }
+    DataManager dm(supports, ntransactions, nattributes, nclasses, data, target);
+
+    // the features of each tree are drawn before the searches, so that they do not depend on the threads
+    vector<vector<Attribute>> features(ntrees);
+    if (max_features > 0) {
+        vector<Attribute> all(nattributes);
+        for (int a = 0; a < nattributes; ++a) all[a] = a;
+        for (int t = 0; t < ntrees; ++t) {
+            mt19937 generator(seed + t);
+            shuffle(all.begin(), all.end(), generator);
+            features[t].assign(all.begin(), all.begin() + max_features);
+            sort(features[t].begin(), features[t].end());
+        }
+    }
+
+    vector<Tree> trees(ntrees);
+    vector<exception_ptr> errors(ntrees);
+    parallel_for(ntrees, [&](int start, int end) {
+        dm.makeCurrent();
+        for (int t = start; t < end; ++t) {
+            try {
+                searchTree(&dm, (sample_weights) ? sample_weights + (long) t * ntransactions : nullptr,
+                           (sample_masks) ? sample_masks + (long) t * ntransactions : nullptr, reg_target, features[t],
+                           maxdepth, minsup, timeLimit, &trees[t]);
+            } catch (...) { errors[t] = current_exception(); }
+        }
+    }, use_threads && ntrees > 1);
+    for (auto &error : errors) if (error) rethrow_exception(error);
+
+    // the trees are stored one after the other with indexes in the whole arrays
+    Tree &nodes = forest->nodes;
+    nodes.nvalues = 1;
+    forest->roots.clear();
+    forest->errors.clear();
+    for (Tree &tree : trees) {
+        int offset = (int) nodes.feature.size();
+        forest->roots.push_back(tree.feature.empty() ? -1 : offset);
+        forest->errors.push_back(tree.feature.empty() ? NO_ERR : tree.trainingError);
+        for (int i = 0; i < (int) tree.feature.size(); ++i) {
+            nodes.feature.push_back(tree.feature[i]);
+            nodes.left.push_back((tree.left[i] < 0) ? -1 : tree.left[i] + offset);
+            nodes.right.push_back((tree.right[i] < 0) ? -1 : tree.right[i] + offset);
+            nodes.value.push_back(tree.value[i]);
+            nodes.error.push_back(tree.error[i]);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef FOREST_H
+#define FOREST_H
+
+#include "dataManager.h"
+#include "query.h"
+#include <vector>
+
+using namespace std;
+
+/**
+ * Forest - the trees learnt by searchForest, stored one after the other in the flat arrays of a Tree (see Tree). The
+ * children are indexes in the whole arrays, as expected by TreePredictor
+ * @param roots - the index of the root of each tree. The root is -1 when no tree is found (e.g. empty sample)
+ * @param errors - the training error of each tree on its sample
+ * @param nodes - the nodes of the trees
+ */
+struct Forest {
+    vector<int> roots;
+    vector<float> errors;
+    Tree nodes;
+};
+
+/** searchForest - learn several trees on the same data, loaded once in a DataManager shared by all the searches. The
+ * sample of each tree is given by a mask or by the multiplicity (weight) of each transaction: the transactions out of
+ * the mask or of null weight are removed from its root cover. Each tree can also test a random subset of the features. The trees are learnt in
+ * parallel and minimize the (weighted) misclassification, or the squared error when reg_target is given
+ *
+ * @param supports - array of support per class for the whole dataset
+ * @param ntransactions - the number of transactions in the dataset
+ * @param nattributes - the number of attributes in the dataset
+ * @param nclasses - the number of classes in the dataset
+ * @param data - the binary features, column by column as for search
+ * @param target - array of targets of the dataset. Null for the regression
+ * @param ntrees - the number of trees to learn
+ * @param sample_weights - the ntransactions weights of the transactions for each tree, tree by tree. Null for unit weights
+ * @param sample_masks - the ntransactions flags of the transactions of the sample (1) of each tree, tree by tree, e.g.
+ * the training examples of the folds of a cross-validation. Unlike null weights, they keep the unweighted cover. Null
+ * when the samples are only given by the weights
+ * @param max_features - the number of features drawn at random (without replacement) for each tree. 0 for all of them
+ * @param seed - the seed of the random draws of the features; the tree t uses seed + t
+ * @param maxdepth - the maximum depth of the trees
+ * @param minsup - the minimum number of transactions covered by each leaf. The transactions of a sample are counted
+ * once whatever their weight, as in search
+ * @param timeLimit - the maximum time allocated for the search of each tree, expressed in seconds. 0 for no limit
+ * @param reg_target - array of numerical targets of the dataset. When it is not null, regression trees are learnt
+ * @param use_threads - whether the trees are learnt in parallel
+ * @param forest - receives the trees
+ */
+void searchForest(Supports supports,
+                  int ntransactions,
+                  int nattributes,
+                  int nclasses,
+                  Bool *data,
+                  Class *target,
+                  int ntrees,
+                  const float *sample_weights,
+                  const Bool *sample_masks,
+                  int max_features,
+                  unsigned seed,
+                  int maxdepth,
+                  int minsup,
+                  int timeLimit,
+                  float *reg_target,
+                  bool use_threads,
+                  Forest *forest);
+
+#endif
@@ -1,12 +1,9 @@
 #include "globals.h"
 #include <math.h>
 
-Class nclasses;
-Attribute nattributes;
+thread_local Class nclasses DL85_TLS_MODEL;
+thread_local Attribute nattributes DL85_TLS_MODEL;
 std::map<int,int> attrFeat;
-int ncall = 0;
-float spectime = 0;
-float comptime = 0;
 float epsilon = 1.0e-05f;
 bool verbose = false;
 
@@ -106,9 +103,6 @@ Array<Item> addItem ( Array<Item> src1, Item item ) {
     if ( j < 1 )
         dest[k++] = item;
 
-    if (verbose) std::cout << "-\nitemset avant ajout : "; printItemset(src1);
-    if (verbose) std::cout << "Item à ajouter : " << item << std::endl;
-    if (verbose) std::cout << "itemset après ajout : "; printItemset(dest);
     return dest;
 }
 
@@ -133,3 +127,20 @@ bool floatEqual(float f1, float f2)
     return abs(f1 - f2) <= epsilon * std::max(abs(f1), abs(f2));
 }*/
 
+
+// split [0, nb_elements) in one contiguous range per hardware thread. The last range runs in the calling thread
+void parallel_for(unsigned nb_elements, std::function<void (int start, int end)> functor, bool use_threads) {
+    unsigned nb_threads = use_threads ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+    nb_threads = std::min(nb_threads, std::max(1u, nb_elements));
+    unsigned batch_size = nb_elements / nb_threads, remainder = nb_elements % nb_threads;
+
+    std::vector<std::thread> threads;
+    int start = 0;
+    for (unsigned i = 0; i < nb_threads; ++i) {
+        int end = start + batch_size + ((i < remainder) ? 1 : 0);
+        if (i + 1 == nb_threads) functor(start, end);
+        else threads.emplace_back(functor, start, end);
+        start = end;
+    }
+    for (auto &t : threads) t.join();
+}
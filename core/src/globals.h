@@ -37,13 +37,19 @@ typedef SupportClass* Supports;
 
 
 extern float epsilon;
-extern Class nclasses;
-extern Attribute nattributes;
+// the initial-exec model keeps the thread-local globals read by the loops of the search as cheap as plain globals
+// when the search is loaded as a shared library (the python extension), for a few bytes of the static TLS
+#if defined(__GNUC__)
+#define DL85_TLS_MODEL __attribute__((tls_model("initial-exec")))
+#else
+#define DL85_TLS_MODEL
+#endif
+
+// the numbers of classes and of attributes of the data searched by the thread (see DataManager::makeCurrent)
+extern thread_local Class nclasses DL85_TLS_MODEL;
+extern thread_local Attribute nattributes DL85_TLS_MODEL;
 extern std::map<int, int> attrFeat;
 extern bool verbose;
-extern int ncall;
-extern float spectime;
-extern float comptime;
 
 
 #define NO_SUP INT_MAX // SHRT_MAX
@@ -0,0 +1,85 @@
+#include "incrementalSearch.h"
+#include "rCoverTotalFreq.h"
+#include "query_totalfreq.h"
+#include "lcm_pruned.h"
+#include <stdexcept>
+
+using namespace std::chrono;
+
+IncrementalSearch::IncrementalSearch(int nattributes, int nclasses, int maxdepth, int minsup, int timeLimit) :
+        nattributes(nattributes), nclasses(nclasses), maxdepth(maxdepth), minsup(minsup), timeLimit(timeLimit),
+        supports(max(nclasses, 2), 0) {
+    if (nattributes < 1 || nclasses < 1) throw invalid_argument("The dataset needs features and classes");
+}
+
+IncrementalSearch::~IncrementalSearch() {
+    delete dm;
+    delete trie;
+}
+
+void IncrementalSearch::addTransactions(Bool *data, Class *target, int ntransactions) {
+    if (ntransactions <= 0) return;
+    if (dm) {
+        dm->addTransactions(data, target, ntransactions);
+        return;
+    }
+    for (int i = 0; i < ntransactions; ++i)
+        if (target[i] < 0 || target[i] >= nclasses) throw invalid_argument("The class of a new transaction is unknown");
+    for (int i = 0; i < ntransactions; ++i) ++supports[target[i]];
+    dm = new DataManager(supports.data(), ntransactions, nattributes, nclasses, data, target);
+}
+
+void IncrementalSearch::getTransactions(Bool *data, Class *target) const {
+    int ntransactions = getNTransactions();
+    // the transaction j is the bit j % M of the word nWords - (j / M + 1), as packed by DataManager
+    auto isSet = [&](const bitset<M> *words, int tid) { return words[dm->nWords - (tid / M + 1)][tid % M]; };
+    for (int i = 0; i < nattributes; ++i)
+        for (int j = 0; j < ntransactions; ++j) data[(long) ntransactions * i + j] = isSet(dm->getAttributeCover(i), j);
+    for (int k = 0; k < nclasses; ++k)
+        for (int j = 0; j < ntransactions; ++j) if (isSet(dm->getClassCover(k), j)) target[j] = k;
+}
+
+// the error of the subtree of a tree on the transactions of the cover
+static Error treeError(const Tree &tree, int node, Query *query, RCover *cover) {
+    if (tree.feature[node] < 0) return query->computeLeafInfo(cover).error;
+    Error error = 0;
+    for (bool positive : {true, false}) {
+        cover->intersect(tree.feature[node], positive);
+        error += treeError(tree, (positive) ? tree.left[node] : tree.right[node], query, cover);
+        cover->backtrack();
+    }
+    return error;
+}
+
+string IncrementalSearch::search(Tree *out_tree) {
+    if (!dm) throw invalid_argument("No transaction has been added");
+    // another search of the thread may have been run since the data manager was created
+    dm->makeCurrent();
+
+    RCoverTotalFreq cover(dm);
+    Trie *next_trie = new Trie;
+    Query_TotalFreq query(minsup, maxdepth, next_trie, dm, timeLimit);
+    // the errors are numbers of transactions, so the previous tree is among the trees better than its error + 1
+    if (!tree.feature.empty()) query.maxError = treeError(tree, 0, &query, &cover) + 1;
+
+    LcmPruned lcm(&cover, &query, false, false, false);
+    // the errors of an interrupted search are not optimal
+    if (minsup == 1 && !tree.timeout) lcm.previous = trie;
+    auto start = high_resolution_clock::now();
+    lcm.run();
+    auto stop = high_resolution_clock::now();
+
+    Tree found{};
+    query.printResult(&found, &cover);
+    found.latSize = lcm.latticesize;
+    found.searchRt = duration<double>(stop - start).count();
+    found.stats = query.stats;
+    if (!found.feature.empty()) query.printSupports(&found, &cover);
+
+    delete trie;
+    trie = next_trie;
+    tree = found;
+    if (out_tree) *out_tree = move(found);
+    return "(nItems, nTransactions) : ( " + to_string(nattributes * 2) + ", " + to_string(dm->getNTransactions()) +
+           " )\n" + tree.to_str();
+}
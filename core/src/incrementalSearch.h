@@ -0,0 +1,64 @@
+#ifndef INCREMENTAL_SEARCH_H
+#define INCREMENTAL_SEARCH_H
+
+#include "dataManager.h"
+#include "trie.h"
+#include "query.h"
+#include <vector>
+
+using namespace std;
+
+/**
+ * IncrementalSearch - learn the optimal classification tree of a dataset growing by batches of transactions. The new
+ * transactions are appended to the packed data (see DataManager::addTransactions) without packing the previous ones
+ * again. The tree itself is not updated incrementally: each search is a complete search of all the transactions, which
+ * visits the nodes again whether or not the new transactions change them. It only starts from the bounds of the
+ * previous search: the misclassification of a set of transactions cannot decrease when transactions are added to it,
+ * so the errors and the lower bounds of the itemsets of the previous trie remain lower bounds, and the error of the
+ * previous tree on the enlarged data is an upper bound of the optimal error. A node whose bound is reached is closed
+ * when it is visited, without trying its attributes. The bounds of the previous trie are not valid with a minimum
+ * support above 1, since a leaf of the new tree may be too small on the previous data; only the upper bound is used in
+ * that case
+ * @param supports - the number of transactions of each class
+ * @param trie - the trie of the last search, or null
+ * @param tree - the last tree found
+ */
+class IncrementalSearch {
+public:
+    IncrementalSearch(int nattributes, int nclasses, int maxdepth, int minsup = 1, int timeLimit = 0);
+
+    ~IncrementalSearch();
+
+    /**
+     * addTransactions - append transactions to the data of the next search
+     * @param data - the binary features of the new transactions, column by column as for search
+     * @param target - the class of each new transaction, between 0 and nclasses - 1
+     * @param ntransactions - the number of new transactions
+     */
+    void addTransactions(Bool *data, Class *target, int ntransactions);
+
+    /**
+     * search - learn the optimal tree of all the transactions added so far
+     * @param tree - receives the tree found, with the supports of its nodes (see Tree)
+     * @return the description of the tree, as returned by the search function
+     */
+    string search(Tree *tree);
+
+    /**
+     * getTransactions - copy the transactions added so far, e.g. to save the search and to add them to a new one
+     * @param data - receives the getNTransactions() values of each feature, column by column as for addTransactions
+     * @param target - receives the class of each transaction
+     */
+    void getTransactions(Bool *data, Class *target) const;
+
+    int getNTransactions() const { return (dm) ? dm->getNTransactions() : 0; }
+
+private:
+    int nattributes, nclasses, maxdepth, minsup, timeLimit;
+    vector<SupportClass> supports;
+    DataManager *dm = nullptr;
+    Trie *trie = nullptr;
+    Tree tree{};
+};
+
+#endif
@@ -11,13 +11,13 @@ LcmPruned::~LcmPruned(){}
 
 // the solution already exists for this node
 TrieNode *existingsolution(TrieNode *node, Error *nodeError) {
-    Logger::showMessageAndReturn("the solution exists and it is worth : ", *nodeError);
+    DL85_TRACE_EVENT("existing solution", "error", *nodeError);
     return node;
 }
 
 // the node does not fullfil the constraints to be splitted (minsup, depth, etc.)
 TrieNode *cannotsplitmore(TrieNode *node, Error ub, Error *nodeError, Error leafError) {
-    Logger::showMessageAndReturn("max depth reached. ub = ", ub, " and leaf error = ", leafError);
+    DL85_TRACE_EVENT("cannot split", "ub", ub, "leaf error", leafError);
     // we return the leaf error as node error without checking the upperbound constraint. The parent will do it
     *nodeError = leafError;
     return node;
@@ -26,13 +26,13 @@ TrieNode *cannotsplitmore(TrieNode *node, Error ub, Error *nodeError, Error leaf
 // the node error is equal to the lower bound
 TrieNode *reachlowest(TrieNode *node, Error *nodeError, Error leafError) {
     *nodeError = leafError;
-    Logger::showMessageAndReturn("lowest error. node error = leaf error = ", *nodeError);
+    DL85_TRACE_EVENT("lowest error", "error", *nodeError);
     return node;
 }
 
 // the upper bound of the node is lower than the lower bound
 TrieNode *infeasiblecase(TrieNode *node, Error *saved_lb, Error ub) {
-    Logger::showMessageAndReturn("no solution bcoz ub < lb. lb =", *saved_lb, " and ub = ", ub);
+    DL85_TRACE_EVENT("infeasible", "lb", *saved_lb, "ub", ub);
     return node;
 }
 
@@ -40,18 +40,21 @@ TrieNode *getSolutionIfExists(TrieNode *node, RCover* cover, Query* query, Error
     Error *nodeError = &(((QDB) node->data)->error);
     // in case the solution exists because the error of a newly created node is set to FLT_MAX
     if (*nodeError < FLT_MAX) {
+        query->stats.cacheHits += 1;
         return existingsolution(node, nodeError);
     }
 
     Error *saved_lb = &(((QDB) node->data)->lowerBound);
     // in case the problem is infeasible
     if (ub <= *saved_lb) {
+        query->stats.prunedInfeasible += 1;
         return infeasiblecase(node, saved_lb, ub);
     }
 
     Error leafError = ((QDB) node->data)->leafError;
     // we reach the lowest value possible. implicitely, the upper bound constraint is not violated
     if (floatEqual(leafError, *saved_lb)) {
+        query->stats.prunedLowest += 1;
         return reachlowest(node, nodeError, leafError);
     }
 
@@ -100,6 +103,7 @@ float LcmPruned::informationGain(Supports notTaken, Supports taken) {
 
 
 Array<Attribute> LcmPruned::getSuccessors(Array<Attribute> last_candidates, Attribute last_added) {
+    StatsTimer timer(query->stats.successorTime);
 
     std::multimap<float, Attribute> gain;
     Array<Attribute> next_candidates(last_candidates.size, 0);
@@ -138,6 +142,7 @@ Array<Attribute> LcmPruned::getSuccessors(Array<Attribute> last_candidates, Attr
                 } else next_candidates.push_back(candidate);
 //            }
         }
+        else query->stats.prunedMinsup += 1;
     }
 
     // if heuristic is used, add the next candidates given the heuristic order
@@ -167,10 +172,57 @@ Array<Attribute> LcmPruned::getExistingSuccessors(TrieNode *node) {
     return candidates;
 }
 
+/* evaluate with a single call to the python batch error function the children of a node which have not been
+ evaluated yet. Their data are created and stored in the trie so that the search reuses them when it visits them */
+void LcmPruned::evaluateChildrenBatch(Array<Item> itemset, Array<Attribute> next_attributes) {
+    LeafBatch batch(query->batch_on_supports);
+    vector<TrieNode *> children;
+    vector<string> cache_keys;
+    for (auto &next : next_attributes) {
+        for (bool positive : {false, true}) {
+            Array<Item> child_itemset = addItem(itemset, item(next, positive));
+            TrieNode *child;
+            {
+                DL85_STATS_TIME(query->stats.cacheTime);
+                child = query->trie->insert(child_itemset);
+            }
+            child_itemset.free();
+            if (child->data) continue;
+            cover->intersect(next, positive);
+            // the children whose cover has already been evaluated are not sent to python
+            if (query->leaf_cache) {
+                LeafInfo cached;
+                string key = query->leafCacheKey(cover);
+                if (query->leaf_cache->find(key, cached)) {
+                    child->data = query->initData(cached);
+                    latticesize++;
+                    cover->backtrack();
+                    continue;
+                }
+                cache_keys.push_back(key);
+            }
+            batch.add(cover);
+            cover->backtrack();
+            children.push_back(child);
+        }
+    }
+    if (children.empty()) return;
+
+    vector<LeafInfo> infos = query->computeBatchLeafInfo(&batch);
+    for (int i = 0; i < (int) children.size(); ++i) {
+        children[i]->data = query->initData(infos[i]);
+        if (query->leaf_cache) query->leaf_cache->insert(cache_keys[i], infos[i]);
+    }
+    latticesize += (int) children.size();
+}
+
 // compute the similarity lower bound based on the best ever seen node or the node with the highest coversize
 Error LcmPruned::computeSimilarityLowerBound(bitset<M> *b1_cover, bitset<M> *b2_cover, Error b1_error, Error b2_error) {
 //    return 0;
-    if (is_python_error) return 0;
+    DL85_STATS_TIME(query->stats.boundTime);
+    // the custom errors which do not state how fast they can decrease have no similarity bound
+    Error per_unit = query->maxErrorPerUnit();
+    if (floatEqual(per_unit, NO_ERR)) return 0;
     Error bound = 0;
     bitset<M>*covers[] = {b1_cover, b2_cover};
     Error errors[] = {b1_error, b2_error};
@@ -179,7 +231,7 @@ Error LcmPruned::computeSimilarityLowerBound(bitset<M> *b1_cover, bitset<M> *b2_
         Error err = errors[i];
         if (cov) {
             SupportClass sumdif = cover->countDif(cov);
-            if (err - sumdif > bound) bound = err - sumdif;
+            if (err - sumdif * per_unit > bound) bound = err - sumdif * per_unit;
         }
     }
     return (bound > 0) ? bound : 0;
@@ -188,6 +240,7 @@ Error LcmPruned::computeSimilarityLowerBound(bitset<M> *b1_cover, bitset<M> *b2_
 // store the node with lowest error as well as the one with the largest cover in order to find a similarity lower bound
 void LcmPruned::addInfoForLowerBound(QueryData *node_data, bitset<M> *&b1_cover, bitset<M> *&b2_cover,
                                     Error &b1_error, Error &b2_error, Support &highest_coversize) {
+    DL85_STATS_TIME(query->stats.boundTime);
 //    if (((QDB) node_data)->error < FLT_MAX) {
     Error err = (((QDB) node_data)->error < FLT_MAX) ? ((QDB) node_data)->error : ((QDB) node_data)->lowerBound;
     Support sup = cover->getSupport();
@@ -207,6 +260,14 @@ void LcmPruned::addInfoForLowerBound(QueryData *node_data, bitset<M> *&b1_cover,
 //    }
 }
 
+// the lower bound of an itemset given by the previous search: its error when it was solved, its lower bound otherwise
+Error LcmPruned::previousLowerBound(Array<Item> itemset) {
+    DL85_STATS_TIME(query->stats.boundTime);
+    TrieNode *node = previous->find(itemset);
+    if (!node || !node->data) return 0;
+    return (((QDB) node->data)->error < FLT_MAX) ? ((QDB) node->data)->error : ((QDB) node->data)->lowerBound;
+}
+
 /** recurse - this method finds the best tree given an itemset and its cover and update
  * the information of the node representing the itemset. Each itemset is represented by a node and info about the
  * tree structure is wrapped into a variable data in the node object. Each itemset (the node) is inserted into the
@@ -230,6 +291,7 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
                              Depth depth,
                              float ub,
                              float computed_lb) {
+    DL85_TRACE_SCOPE("recurse");
 
     // check if we ran out of time
     if (query->timeLimit > 0) {
@@ -240,13 +302,16 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
 
     // the node data already exists because it is not null like how it is when it is just created
     if (node->data) {
-        Logger::showMessageAndReturn("the node exists");
+        DL85_TRACE_EVENT("existing node", "depth", depth, "ub", ub);
         TrieNode* result = getSolutionIfExists(node, cover, query, ub, depth);
         if (result) return result;
     }
 
+    // the bound of the itemset in the previous search is a lower bound of its error
+    if (previous) computed_lb = max(computed_lb, previousLowerBound(itemset));
+
     // in case the solution cannot be derived without computation and remaining depth is 2, we use a specific algorithm
-    if (query->maxdepth - depth == 2 && cover->getSupport() >= 2 * query->minsup && no_python_error) {
+    if (query->maxdepth - depth == 2 && cover->getSupport() >= 2 * query->minsup && supports_based_error) {
         return computeDepthTwo(cover, ub, next_candidates, last_added, itemset, node, query, computed_lb, query->trie);
     }
 
@@ -263,12 +328,14 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
      no need to insert the node into the trie. It has just been created and inserted into the trie
      before the call to this function. we will just the data object (QDB) and its information*/
     if (!node->data) {
-        Logger::showMessageAndReturn("New node");
         latticesize++;
+        DL85_TRACE_COUNTER("lattice size", latticesize);
 
         // Create data object and initialize its variables, then get them for the search
         node->data = query->initData(cover);
-        Logger::showMessageAndReturn("after init of the new node. ub = ", ub, " and leaf error = ", ((QDB) node->data)->leafError);
+        if (previous) ((QDB) node->data)->lowerBound = max(((QDB) node->data)->lowerBound,
+                                                           min(computed_lb, ((QDB) node->data)->leafError));
+        DL85_TRACE_EVENT("new node", "depth", depth, "ub", ub, "leaf error", ((QDB) node->data)->leafError);
         TrieNode* result = getSolutionIfExists(node, cover, query, ub, depth);
         if (result) return result;
 
@@ -279,7 +346,7 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
     else {
         Error leafError = ((QDB) node->data)->leafError;
         Error *nodeError = &(((QDB) node->data)->error);
-        Logger::showMessageAndReturn("existing node without solution and higher bound. leaf error = ", leafError, " new ub = ", ub);
+        DL85_TRACE_EVENT("existing node without solution", "depth", depth, "ub", ub, "leaf error", leafError);
 
         if (query->timeLimitReached) {
             *nodeError = leafError;
@@ -298,12 +365,13 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
     Error leafError = ((QDB) node->data)->leafError;
     Error *nodeError = &(((QDB) node->data)->error);
 
+    // the leaf errors of the children are computed at once when the python error function works on batches
+    if (query->batch_error_class_callback && next_attributes.size > 0) evaluateChildrenBatch(itemset, next_attributes);
+
     // case in which there is no candidate
     if (next_attributes.size == 0) {
-        Logger::showMessageAndReturn("No candidates. nodeError is set to leafError");
         *nodeError = leafError;
-        Logger::showMessageAndReturn("depth = ", depth, " and init ub = ", ub, " and error after search = ", *nodeError);
-        Logger::showMessageAndReturn("we backtrack");
+        DL85_TRACE_EVENT("no candidate", "depth", depth, "error", *nodeError);
         next_attributes.free();
         return node;
     }
@@ -323,7 +391,7 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
 
     // we evaluate the split on each candidate attribute
     for(auto& next : next_attributes) {
-        Logger::showMessageAndReturn("\n\nWe are evaluating the attribute : ", next);
+        DL85_TRACE_EVENT("attribute", "attribute", next, "depth", depth);
 
         Array<Item> itemsets[2];
         TrieNode *nodes[2];
@@ -336,13 +404,13 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
          want to use it, please comment the next block. 0/1 order is used in this case.*/
 
         //=========================== BEGIN BLOCK ==========================//
-        cover->intersect(next, false);
+        { DL85_STATS_TIME(query->stats.intersectTime); cover->intersect(next, false); }
         first_lb = computeSimilarityLowerBound(b1_cover, b2_cover, b1_error, b2_error);
-        cover->backtrack();
+        { DL85_STATS_TIME(query->stats.intersectTime); cover->backtrack(); }
 
-        cover->intersect(next);
+        { DL85_STATS_TIME(query->stats.intersectTime); cover->intersect(next); }
         second_lb = computeSimilarityLowerBound(b1_cover, b2_cover, b1_error, b2_error);
-        cover->backtrack();
+        { DL85_STATS_TIME(query->stats.intersectTime); cover->backtrack(); }
         //=========================== END BLOCK ==========================//
 
 
@@ -350,9 +418,9 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
         second_item = !first_item;
 
         // perform search on the first item
-        cover->intersect(next, first_item);
+        { DL85_STATS_TIME(query->stats.intersectTime); cover->intersect(next, first_item); }
         itemsets[first_item] = addItem(itemset, item(next, first_item));
-        nodes[first_item] = query->trie->insert(itemsets[first_item]);
+        { DL85_STATS_TIME(query->stats.cacheTime); nodes[first_item] = query->trie->insert(itemsets[first_item]); }
         // if lower bound was not computed
         if (floatEqual(first_lb, -1)) first_lb = computeSimilarityLowerBound(b1_cover, b2_cover, b1_error, b2_error);
         // the best lower bound between the computed and the saved is used
@@ -365,13 +433,13 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
         //cout << "after good bound 1" << " sc[0] = " << b1_sc[0] << " sc[1] = " << b1_sc[1] << " err = " << ((QDB)nodes[first_item]->data)->error << endl;
         Error firstError = ((QDB) nodes[first_item]->data)->error;
         itemsets[first_item].free();
-        cover->backtrack();
+        { DL85_STATS_TIME(query->stats.intersectTime); cover->backtrack(); }
 
         if (query->canimprove(nodes[first_item]->data, child_ub)) {
             // perform search on the second item
-            cover->intersect(next, second_item);
+            { DL85_STATS_TIME(query->stats.intersectTime); cover->intersect(next, second_item); }
             itemsets[second_item] = addItem(itemset, item(next, second_item));
-            nodes[second_item] = query->trie->insert(itemsets[second_item]);
+            { DL85_STATS_TIME(query->stats.cacheTime); nodes[second_item] = query->trie->insert(itemsets[second_item]); }
             if (floatEqual(second_lb, -1)) second_lb = computeSimilarityLowerBound(b1_cover, b2_cover, b1_error, b2_error);
             // the best lower bound between the computed and the saved is used
             second_lb = (nodes[second_item]->data) ? max(((QDB) nodes[second_item]->data)->lowerBound, second_lb) : second_lb;
@@ -384,19 +452,21 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
             addInfoForLowerBound(nodes[second_item]->data, b1_cover, b2_cover, b1_error, b2_error, highest_coversize);
             Error secondError = ((QDB) nodes[second_item]->data)->error;
             itemsets[second_item].free();
-            cover->backtrack();
+            { DL85_STATS_TIME(query->stats.intersectTime); cover->backtrack(); }
 
             Error feature_error = firstError + secondError;
             bool hasUpdated = query->updateData(node->data, child_ub, next, nodes[0]->data, nodes[1]->data);
             if (hasUpdated) {
                 child_ub = feature_error;
-                Logger::showMessageAndReturn("-\nafter this attribute, node error=", *nodeError, " and ub=", child_ub);
+                DL85_TRACE_EVENT("better split", "attribute", next, "error", *nodeError, "ub", child_ub);
             }
             // in case we get the real error, we update the minimum possible error
             else minlb = min(minlb, feature_error);
 
             if (query->canSkip(node->data)) {//lowerBound reached
-                Logger::showMessageAndReturn("We get the best solution. So, we break the remaining attributes");
+                DL85_TRACE_EVENT("lower bound reached", "attribute", next, "error", *nodeError);
+                // the attributes after this one are not tried
+                query->stats.prunedCanSkip += (next_attributes.elts + next_attributes.size) - (&next + 1);
                 break; //prune remaining attributes not browsed yet
             }
         } else { //we do not attempt the second child, so we use its lower bound
@@ -422,7 +492,7 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
         *lb = max(ub, minlb);
     }
 
-    Logger::showMessageAndReturn("depth = ", depth, " and init ub = ", ub, " and error after search = ", *nodeError);
+    DL85_TRACE_EVENT("node searched", "depth", depth, "ub", ub, "error", *nodeError);
 
     next_attributes.free();
 //        itemset.free();
@@ -433,22 +503,25 @@ TrieNode *LcmPruned::recurse(Array<Item> itemset,
 
 
 void LcmPruned::run() {
+    DL85_TRACE_SCOPE("search");
     query->setStartTime();
     // set the correct maxerror if needed
     float maxError = NO_ERR;
     if (query->maxError > 0) maxError = query->maxError;
 
     // Create empty list for candidate attributes
-    Array<Attribute> attributes_to_visit(nattributes, 0);
+    if (attributes.empty()) for (int attr = 0; attr < nattributes; ++attr) attributes.push_back(attr);
+    Array<Attribute> attributes_to_visit(attributes.size(), 0);
 
     // Update the candidate list based on frequency criterion
     if (query->minsup == 1) { // do not check frequency if minsup = 1
-        for (int attr = 0; attr < nattributes; ++attr) attributes_to_visit.push_back(attr);
+        for (int attr : attributes) attributes_to_visit.push_back(attr);
     }
     else { // make sure each candidate attribute can be split into two nodes fulfilling the frequency criterion
-        for (int attr = 0; attr < nattributes; ++attr) {
+        for (int attr : attributes) {
             if (cover->temporaryIntersectSup(attr, false) >= query->minsup && cover->temporaryIntersectSup(attr) >= query->minsup)
                 attributes_to_visit.push_back(attr);
+            else query->stats.prunedMinsup += 1;
         }
     }
 
@@ -467,9 +540,5 @@ void LcmPruned::run() {
     itemset.free();
     attributes_to_visit.free();
 
-    /*cout << "ncall: " << ncall << endl;
-    cout << "comptime: " << comptime << endl;
-    cout << "searchtime: " << spectime << endl;
-    cout << "totaltime: " << comptime + spectime << endl;
-    ncall = 0; comptime = 0; spectime = 0;*/
+    if (verbose) cout << query->stats.to_str();
 }
\ No newline at end of file
@@ -18,7 +18,9 @@
 #include "rCover.h"
 #include "depthTwoComputer.h"
 #include "query_best.h" // if cannot link is specified, we need a clustering problem!!!
-#include "logger.h"
+#include "nativeError.h"
+#include "leafCache.h"
+#include "tracing.h"
 
 
 
@@ -32,6 +34,13 @@ public:
 
     int latticesize = 0;
 
+    // the attributes that can be tested by the tree. All the attributes when it is empty
+    vector<Attribute> attributes;
+
+    // the trie of a previous search on a subset of the transactions (see IncrementalSearch), or null. The errors of
+    // its itemsets cannot decrease when transactions are added, so they are lower bounds of the errors of this search
+    Trie *previous = nullptr;
+
     Query *query;
 
     RCover *cover;
@@ -44,6 +53,8 @@ protected:
 
     Array<Attribute> getExistingSuccessors(TrieNode* node);
 
+    void evaluateChildrenBatch(Array<Item> itemset, Array<Attribute> next_attributes);
+
     Error computeSimilarityLowerBound(bitset<M> *b1_cover, bitset<M> *b2_cover, Error b1_error, Error b2_error);
 
     void addInfoForLowerBound(QueryData *node_data, bitset<M> *&b1_cover, bitset<M> *&b2_cover,
@@ -51,6 +62,8 @@ protected:
 
     float informationGain ( Supports notTaken, Supports taken);
 
+    Error previousLowerBound(Array<Item> itemset);
+
 
     bool infoGain = false;
     bool infoAsc = false; //if true ==> items with low IG are explored first
@@ -59,9 +72,13 @@ protected:
 };
 
 // a variable to express whether the error computation is not performed in python or not
-#define no_python_error !query->tids_error_callback && !query->tids_error_class_callback && !query->supports_error_class_callback
+#define no_python_error !query->tids_error_callback && !query->tids_error_class_callback && !query->supports_error_class_callback && !query->batch_error_class_callback
 
 // a variable to express whether the error computation is performed in python or not
-#define is_python_error query->tids_error_callback || query->tids_error_class_callback || query->supports_error_class_callback
+#define is_python_error query->tids_error_callback || query->tids_error_class_callback || query->supports_error_class_callback || query->batch_error_class_callback
+
+// a variable to express whether the leaf error can be derived from the supports per class. It is required by the
+// depth two algorithm and the similarity lower bound
+#define supports_based_error ((no_python_error) && query->isAdditive())
 
 #endif
\ No newline at end of file
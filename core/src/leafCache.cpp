@@ -0,0 +1,24 @@
+#include "leafCache.h"
+
+bool LeafCache::find(const string &key, LeafInfo &info) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        ++misses;
+        return false;
+    }
+    // move the entry in front of the list to keep it longer
+    entries.splice(entries.begin(), entries, it->second);
+    info = it->second->second;
+    ++hits;
+    return true;
+}
+
+void LeafCache::insert(const string &key, LeafInfo info) {
+    if (capacity <= 0 || index.find(key) != index.end()) return;
+    if ((int) entries.size() >= capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+    entries.emplace_front(key, info);
+    index[key] = entries.begin();
+}
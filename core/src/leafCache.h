@@ -0,0 +1,41 @@
+#ifndef DL85_LEAFCACHE_H
+#define DL85_LEAFCACHE_H
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "globals.h"
+#include "query.h"
+
+using namespace std;
+
+/**
+ * LeafCache - a bounded memo table of the leaf errors returned by the python error functions. The same cover is
+ * often reached through different itemsets and each evaluation would enter python again. The key is a fingerprint
+ * of the cover or the supports per class of the cover, depending on what the error function receives. When the
+ * table is full, the least recently used entry is evicted
+ * @param capacity - the maximum number of entries
+ * @param hits - the number of lookups which found their entry
+ * @param misses - the number of lookups which did not find their entry
+ */
+class LeafCache {
+public:
+    explicit LeafCache(int capacity) : capacity(capacity) {}
+
+    bool find(const string &key, LeafInfo &info);
+
+    void insert(const string &key, LeafInfo info);
+
+    int size() const { return (int) entries.size(); }
+
+    int capacity;
+    int hits = 0;
+    int misses = 0;
+
+private:
+    list<pair<string, LeafInfo>> entries; // the most recently used entry first
+    unordered_map<string, list<pair<string, LeafInfo>>::iterator> index;
+};
+
+#endif //DL85_LEAFCACHE_H
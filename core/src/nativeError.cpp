@@ -0,0 +1,54 @@
+#include "nativeError.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#define dl85_open(path) ((void *) LoadLibraryA(path))
+#define dl85_symbol(handle, name) ((void *) GetProcAddress((HMODULE) handle, name))
+#define dl85_close(handle) FreeLibrary((HMODULE) handle)
+#else
+#include <dlfcn.h>
+#define dl85_open(path) dlopen(path, RTLD_NOW | RTLD_LOCAL)
+#define dl85_symbol(handle, name) dlsym(handle, name)
+#define dl85_close(handle) dlclose(handle)
+#endif
+
+PluginError::PluginError(const string &path) {
+    handle = dl85_open(path.c_str());
+    if (!handle) throw runtime_error("Unable to load the error plugin " + path);
+
+    tids_error = (dl85_leaf_error_t) dl85_symbol(handle, "dl85_leaf_error");
+    supports_error = (dl85_leaf_error_from_supports_t) dl85_symbol(handle, "dl85_leaf_error_from_supports");
+    if (!tids_error && !supports_error) {
+        dl85_close(handle);
+        throw runtime_error("The error plugin " + path + " exports neither dl85_leaf_error nor dl85_leaf_error_from_supports");
+    }
+
+    // an error computed only from the transactions ids cannot be used where only the supports are known
+    auto is_additive = (dl85_error_is_additive_t) dl85_symbol(handle, "dl85_error_is_additive");
+    additive = supports_error && is_additive && is_additive() != 0;
+
+    auto max_error_per_unit = (dl85_error_max_per_unit_t) dl85_symbol(handle, "dl85_error_max_per_unit");
+    if (max_error_per_unit) max_per_unit = max_error_per_unit();
+}
+
+PluginError::~PluginError() {
+    if (handle) dl85_close(handle);
+}
+
+LeafInfo PluginError::leafError(RCover *cover) {
+    float out[3] = {NO_ERR, -1, 0};
+    if (tids_error) {
+        vector<int> tids = cover->getTransactionsID();
+        tids_error(tids.data(), (int) tids.size(), out);
+    }
+    else supports_error(cover->getSupportPerClass(), nclasses, out);
+    return {out[0], (Class) out[1], out[2]};
+}
+
+LeafInfo PluginError::leafErrorFromSupports(Supports supports) {
+    if (!supports_error) throw logic_error("The error plugin cannot compute the error from the supports per class");
+    float out[3] = {NO_ERR, -1, 0};
+    supports_error(supports, nclasses, out);
+    return {out[0], (Class) out[1], out[2]};
+}
@@ -0,0 +1,83 @@
+#ifndef DL85_NATIVEERROR_H
+#define DL85_NATIVEERROR_H
+
+#include <string>
+#include <vector>
+#include "globals.h"
+#include "rCover.h"
+#include "query.h"
+
+using namespace std;
+
+/**
+ * NativeError - interface of a user-specific error function evaluated in C++. It replaces the python callbacks
+ * (tids_error_class_callback, supports_error_class_callback, tids_error_callback) when the per node cost of
+ * entering the python interpreter is too high
+ */
+class NativeError {
+public:
+    virtual ~NativeError() {}
+
+    /// error and class of a leaf given its cover. The transactions ids can be retrieved with cover->getTransactionsID()
+    virtual LeafInfo leafError(RCover *cover) = 0;
+
+    /// error and class of a leaf given its support per class. It is only called when the error is additive
+    virtual LeafInfo leafErrorFromSupports(Supports supports) = 0;
+
+    /**
+     * isAdditive - state whether the error of a leaf only depends on its support per class and whether a
+     * transaction can not change it by more than its weight (like the misclassification error). When it is the
+     * case, the depth two algorithm and the similarity lower bound remain enabled
+     */
+    virtual bool isAdditive() { return false; }
+
+    /**
+     * maxErrorPerUnit - the highest decrease of the error of a leaf when a transaction of unit weight is removed from
+     * its cover. The similarity lower bound is disabled when it is unknown (NO_ERR)
+     */
+    virtual Error maxErrorPerUnit() { return isAdditive() ? 1 : NO_ERR; }
+};
+
+/* C interface expected from a shared object loaded as error plugin. At least one of the two error functions
+ * must be exported. For each of them, out[0] must be set to the error of the leaf and out[1] to its class. out[2] may
+ * be set to a lower bound of the error of any tree built on the leaf; it is 0 otherwise
+ *
+ * extern "C" void dl85_leaf_error(const int *tids, int ntids, float *out);
+ * extern "C" void dl85_leaf_error_from_supports(const float *supports, int nclasses, float *out);
+ * extern "C" int dl85_error_is_additive(); // optional. Non-zero when the error is additive
+ * extern "C" float dl85_error_max_per_unit(); // optional. The highest decrease of a leaf error per removed transaction
+ */
+extern "C" {
+typedef void (*dl85_leaf_error_t)(const int *tids, int ntids, float *out);
+typedef void (*dl85_leaf_error_from_supports_t)(const float *supports, int nclasses, float *out);
+typedef int (*dl85_error_is_additive_t)();
+typedef float (*dl85_error_max_per_unit_t)();
+}
+
+/**
+ * PluginError - a native error whose functions are loaded at runtime from a shared object (.so, .dylib, .dll)
+ * exporting the C interface above
+ */
+class PluginError : public NativeError {
+public:
+    explicit PluginError(const string &path);
+
+    ~PluginError();
+
+    LeafInfo leafError(RCover *cover);
+
+    LeafInfo leafErrorFromSupports(Supports supports);
+
+    bool isAdditive() { return additive; }
+
+    Error maxErrorPerUnit() { return (max_per_unit > 0) ? max_per_unit : NativeError::maxErrorPerUnit(); }
+
+private:
+    void *handle = nullptr;
+    dl85_leaf_error_t tids_error = nullptr;
+    dl85_leaf_error_from_supports_t supports_error = nullptr;
+    bool additive = false;
+    Error max_per_unit = 0;
+};
+
+#endif //DL85_NATIVEERROR_H
@@ -1,6 +1,8 @@
 #include "query.h"
+#include "nativeError.h"
 #include <climits>
 #include <cfloat>
+#include <stdexcept>
 
 Query::Query(Support minsup,
              Depth maxdepth,
@@ -8,10 +10,15 @@ Query::Query(Support minsup,
              DataManager *dm,
              int timeLimit,
              function<vector<float>(RCover *)> *tids_error_class_callback,
-             function<vector<float>(RCover *)> *supports_error_class_callback,
+             function<void(Supports, float *)> *supports_error_class_callback,
              function<float(RCover *)> *tids_error_callback,
              float maxError,
-             bool stopAfterError) : dm(dm),
+             bool stopAfterError,
+             NativeError *native_error,
+             function<vector<float>(LeafBatch *)> *batch_error_class_callback,
+             bool batch_on_supports,
+             LeafCache *leaf_cache,
+             Error error_decrease_bound) : dm(dm),
                                     trie(trie),
                                     minsup(minsup),
                                     maxdepth(maxdepth),
@@ -20,11 +27,100 @@ Query::Query(Support minsup,
                                     stopAfterError(stopAfterError),
                                     tids_error_class_callback(tids_error_class_callback),
                                     supports_error_class_callback(supports_error_class_callback),
-                                    tids_error_callback(tids_error_callback)
+                                    tids_error_callback(tids_error_callback),
+                                    native_error(native_error),
+                                    batch_error_class_callback(batch_error_class_callback),
+                                    batch_on_supports(batch_on_supports),
+                                    leaf_cache(leaf_cache),
+                                    error_decrease_bound(error_decrease_bound)
 {}
 
 
 Query::~Query() {
 }
 
+/**
+ * leafCacheKey - compute the key of the current cover in the memo table of the python error functions. The supports
+ * per class are used when the error function only receives them, otherwise a fingerprint of the cover is used
+ * @param cover - the cover of the leaf
+ * @return the key as a string of bytes
+ */
+string Query::leafCacheKey(RCover *cover) {
+    if (supports_error_class_callback || (batch_error_class_callback && batch_on_supports)) {
+        Supports sc = cover->getSupportPerClass();
+        return string((const char *) sc, nclasses * sizeof(SupportClass));
+    }
+    pair<unsigned long long, unsigned long long> fingerprint = cover->fingerprint();
+    Support sup = cover->getSupport();
+    string key((const char *) &fingerprint.first, sizeof(fingerprint.first));
+    key.append((const char *) &fingerprint.second, sizeof(fingerprint.second));
+    key.append((const char *) &sup, sizeof(sup));
+    return key;
+}
+
+/**
+ * isAdditive - state whether the error of a leaf can be derived from its supports per class. It is required by the
+ * depth two algorithm and the similarity lower bound
+ */
+bool Query::isAdditive() {
+    return native_error == nullptr || native_error->isAdditive();
+}
+
+/**
+ * maxErrorPerUnit - the highest decrease of the error of a leaf when a transaction of unit weight is removed from
+ * its cover, i.e. error(cover) >= error(cover') - maxErrorPerUnit * |cover' \ cover|. It scales the similarity lower
+ * bound. The custom errors do not guarantee any such value unless it is given by the user or by the native error
+ * @return the highest decrease or NO_ERR when it is unknown
+ */
+Error Query::maxErrorPerUnit() {
+    if (error_decrease_bound > 0) return error_decrease_bound;
+    if (native_error) return native_error->maxErrorPerUnit();
+    if (tids_error_callback || tids_error_class_callback || supports_error_class_callback || batch_error_class_callback)
+        return NO_ERR;
+    return 1;
+}
+
+// add the leaf represented by the current state of the cover at the end of the batch
+void LeafBatch::add(RCover *cover) {
+    if (use_supports) {
+        Supports sc = cover->getSupportPerClass();
+        supports.insert(supports.end(), sc, sc + nclasses);
+        indptr.push_back(indptr.back() + 1);
+    } else {
+        vector<int> cover_tids = cover->getTransactionsID();
+        tids.insert(tids.end(), cover_tids.begin(), cover_tids.end());
+        indptr.push_back((int) tids.size());
+    }
+}
+
+/**
+ * computeBatchLeafInfo - compute the error and the class of all the leaves of a batch with a single call to the
+ * python batch error function. The function returns the errors of the leaves followed by their classes and,
+ * optionally, by lower bounds of the errors of the trees built on them. The classes can be omitted when the task has
+ * no target
+ * @param batch - the leaves to evaluate
+ * @return the error and the class of each leaf, in the batch order. A runtime_error is thrown when the function returns
+ * less than an error per leaf
+ */
+vector<LeafInfo> Query::computeBatchLeafInfo(LeafBatch *batch) {
+    function<vector<float>(LeafBatch *)> callback = *batch_error_class_callback;
+    vector<float> infos;
+    {
+        StatsTimer timer(stats.callbackTime);
+        infos = callback(batch);
+    }
+    int n = batch->size();
+    // the bridge with python returns an empty result when the function raises an exception
+    if ((int) infos.size() < n)
+        throw runtime_error("The batch error function returned " + to_string(infos.size()) + " values for " +
+                            to_string(n) + " leaves. It must return an error per leaf, and may have raised an exception");
+    vector<LeafInfo> leaves(n);
+    for (int i = 0; i < n; ++i) {
+        leaves[i].error = infos[i];
+        leaves[i].maxclass = ((int) infos.size() >= 2 * n) ? int(infos[n + i]) : -1;
+        leaves[i].lowerBound = ((int) infos.size() >= 3 * n) ? infos[2 * n + i] : 0;
+    }
+    return leaves;
+}
+
 
@@ -5,8 +5,10 @@
 #include "globals.h"
 #include "rCover.h"
 #include "dataManager.h"
+#include "searchStats.h"
 #include <iostream>
 #include <cfloat>
+#include <cmath>
 #include <functional>
 #include <vector>
 #include <chrono>
@@ -15,6 +17,10 @@ struct TrieNode;
 
 class Trie;
 
+class NativeError;
+
+class LeafCache;
+
 using namespace std;
 using namespace std::chrono;
 
@@ -31,6 +37,27 @@ typedef void *QueryData; // using void pointers is much lighter than class deriv
 struct LeafInfo {
     Error error;
     Class maxclass;
+    Error lowerBound; // optional lower bound of the error of any tree built on the leaf. 0 when it is unknown
+};
+
+/**
+ * LeafBatch - a set of leaves whose errors are computed with a single call to the python batch error function
+ * @param use_supports - whether the leaves are described by their supports per class or by their transactions
+ * @param tids - the transactions ids of all the leaves, one after the other
+ * @param indptr - the transactions of the i-th leaf are tids[indptr[i]:indptr[i+1]] (CSR-like layout)
+ * @param supports - the supports per class of all the leaves, row by row (number of leaves x number of classes)
+ */
+struct LeafBatch {
+    bool use_supports;
+    vector<int> tids;
+    vector<int> indptr;
+    vector<SupportClass> supports;
+
+    explicit LeafBatch(bool use_supports = false) : use_supports(use_supports), indptr(1, 0) {}
+
+    void add(RCover *cover);
+
+    int size() const { return (int) indptr.size() - 1; }
 };
 
 /**
@@ -42,6 +69,11 @@ struct LeafInfo {
  * @param latSize - the number of nodes explored before finding the solution. Currently this value is not correct :-(
  * @param searchRt - the time that the search took
  * @param timeout - a boolean variable to represent the fact that the search reached a timeout or not
+ * @param feature, left, right, value, error - the tree as arrays, the nodes being numbered in preorder. The node i
+ * tests the feature feature[i]: the transactions having the feature go to the node left[i] and the others go to the
+ * node right[i]. A leaf has the feature and the children -1 and predicts value[i * nvalues : (i + 1) * nvalues]; the
+ * values of the internal nodes are NaN. error[i] is the error of the subtree of the node i
+ * @param nvalues - the number of values predicted by a leaf (e.g. one per target)
  */
 struct Tree {
     string expression;
@@ -52,6 +84,30 @@ struct Tree {
     float searchRt;
     float accuracy;
     bool timeout;
+    vector<int> feature;
+    vector<int> left;
+    vector<int> right;
+    vector<float> value;
+    vector<float> error;
+    int nvalues = 1;
+    vector<int> transactionLeaf; // the leaf of each training transaction. Only filled for the trees returned by search
+    // the number of training transactions of each node, their weight and their distribution: the ndistribution supports
+    // of the classes, or the values of the node as a leaf for the regression. Only filled for the trees returned by search
+    vector<int> nodeSamples;
+    vector<float> nodeWeight;
+    vector<float> nodeDistribution;
+    int ndistribution = 0;
+    SearchStats stats; // the statistics of the search which found the tree. Only filled for the trees returned by search
+
+    // append a node to the arrays and return its index. The children are set when they are added
+    int addNode(int feat, Error err) {
+        feature.push_back(feat);
+        left.push_back(-1);
+        right.push_back(-1);
+        error.push_back(err);
+        value.insert(value.end(), nvalues, NAN);
+        return (int) feature.size() - 1;
+    }
 
 
     string to_str() const {
@@ -79,10 +135,15 @@ public:
           DataManager *dm,
           int timeLimit,
           function<vector<float>(RCover *)> *tids_error_class_callback = nullptr,
-          function<vector<float>(RCover *)> *supports_error_class_callback = nullptr,
+          function<void(Supports, float *)> *supports_error_class_callback = nullptr,
           function<float(RCover *)> *tids_error_callback = nullptr,
           float maxError = NO_ERR,
-          bool stopAfterError = false);
+          bool stopAfterError = false,
+          NativeError *native_error = nullptr,
+          function<vector<float>(LeafBatch *)> *batch_error_class_callback = nullptr,
+          bool batch_on_supports = false,
+          LeafCache *leaf_cache = nullptr,
+          Error error_decrease_bound = 0);
 
     virtual ~Query();
 
@@ -96,13 +157,27 @@ public:
 
     virtual QueryData *initData(RCover *tid, Depth currentMaxDepth = -1) = 0;
 
+    virtual QueryData *initData(LeafInfo leafInfo) = 0;
+
     virtual LeafInfo computeLeafInfo(RCover *cover) = 0;
 
     virtual LeafInfo computeLeafInfo(Supports itemsetSupport) = 0;
 
+    vector<LeafInfo> computeBatchLeafInfo(LeafBatch *batch);
+
+    string leafCacheKey(RCover *cover);
+
+    virtual bool isAdditive();
+
+    virtual Error maxErrorPerUnit();
+
     virtual bool updateData(QueryData *best, Error upperBound, Attribute attribute, QueryData *left, QueryData *right) = 0;
 
-    virtual void printResult(Tree *tree) = 0;
+    /**
+     * printResult - fill the tree found by the search
+     * @param cover - the root cover of the search, whose weight gives the training accuracy
+     */
+    virtual void printResult(Tree *tree, RCover *cover) = 0;
 
     void setStartTime() { startTime = high_resolution_clock::now(); }
 
@@ -117,8 +192,14 @@ public:
     float maxError = NO_ERR;
     bool stopAfterError = false;
     function<vector<float>(RCover *)> *tids_error_class_callback = nullptr;
-    function<vector<float>(RCover *)> *supports_error_class_callback = nullptr;
+    function<void(Supports, float *)> *supports_error_class_callback = nullptr;
     function<float(RCover *)> *tids_error_callback = nullptr;
+    NativeError *native_error = nullptr;
+    function<vector<float>(LeafBatch *)> *batch_error_class_callback = nullptr;
+    bool batch_on_supports = false;
+    LeafCache *leaf_cache = nullptr;
+    Error error_decrease_bound = 0; // user-given value of maxErrorPerUnit for the custom errors. 0 when it is unknown
+    SearchStats stats;
 
 };
 
@@ -9,10 +9,15 @@ Query_Best::Query_Best(Support minsup,
                        DataManager *data,
                        int timeLimit,
                        function<vector<float>(RCover *)> *tids_error_class_callback,
-                       function<vector<float>(RCover *)> *supports_error_class_callback,
+                       function<void(Supports, float *)> *supports_error_class_callback,
                        function<float(RCover *)> *tids_error_callback,
                        float maxError,
-                       bool stopAfterError)
+                       bool stopAfterError,
+                       NativeError *native_error,
+                       function<vector<float>(LeafBatch *)> *batch_error_class_callback,
+                       bool batch_on_supports,
+                       LeafCache *leaf_cache,
+                       Error error_decrease_bound)
         : Query(minsup,
                 maxdepth,
                 trie,
@@ -22,18 +27,23 @@ Query_Best::Query_Best(Support minsup,
                 supports_error_class_callback,
                 tids_error_callback,
                 maxError,
-                stopAfterError){
+                stopAfterError,
+                native_error,
+                batch_error_class_callback,
+                batch_on_supports,
+                leaf_cache,
+                error_decrease_bound){
 }
 
 
 Query_Best::~Query_Best() {}
 
 
-void Query_Best::printResult(Tree *tree) {
-    printResult((QueryData_Best *) realroot->data, tree);
+void Query_Best::printResult(Tree *tree, RCover *cover) {
+    printResult((QueryData_Best *) realroot->data, tree, cover);
 }
 
-void Query_Best::printResult(QueryData_Best *data, Tree *tree) {
+void Query_Best::printResult(QueryData_Best *data, Tree *tree, RCover *cover) {
     int depth;
     if (data->size == 0 || (data->size == 1 && floatEqual(data->error, FLT_MAX))) {
         tree->expression = "(No such tree)";
@@ -41,30 +51,67 @@ void Query_Best::printResult(QueryData_Best *data, Tree *tree) {
     }
     else {
         tree->expression = "";
+        tree->nvalues = nLeafValues();
         depth = printResult(data, 1, tree);
         tree->expression += "}";
         tree->size = data->size;
         tree->depth = depth - 1;
         tree->trainingError = data->error;
-        tree->accuracy = 1 - tree->trainingError / float(dm->getNTransactions());
+        // the root cover holds the transactions searched: those of the mask of a fold, weighted as in the search
+        tree->accuracy = 1 - tree->trainingError / cover->getWeight();
         if (timeLimitReached) tree->timeout = true;
     }
 }
 
 int Query_Best::printResult(QueryData_Best *data, int depth, Tree *tree) {
+    int node = tree->addNode((data->left) ? data->test : -1, data->error);
     if (!data->left) { // leaf
         if (tids_error_callback) tree->expression += R"({"value": "undefined", "error": )" + std::to_string(data->error);
-        else tree->expression += "{\"value\": " + std::to_string(data->test) + ", \"error\": " + std::to_string(data->error);
+        else {
+            tree->expression += "{\"value\": " + std::to_string(data->test) + ", \"error\": " + std::to_string(data->error);
+            tree->value[node] = data->test;
+        }
         return depth;
     }
     else {
         tree->expression += "{\"feat\": " + std::to_string(data->test) + ", \"left\": ";
 
         // perhaps strange, but we have stored the positive outcome in right, generally, people think otherwise... :-)
+        tree->left[node] = (int) tree->feature.size();
         int left_depth = printResult(data->right, depth + 1, tree);
         tree->expression += "}, \"right\": ";
+        tree->right[node] = (int) tree->feature.size();
         int right_depth = printResult(data->left, depth + 1, tree);
         tree->expression += "}";
         return max(left_depth, right_depth);
     }
 }
+
+void Query_Best::printSupports(Tree *tree, RCover *cover) {
+    int nnodes = (int) tree->feature.size();
+    tree->ndistribution = nDistributionValues();
+    tree->nodeSamples.assign(nnodes, 0);
+    tree->nodeWeight.assign(nnodes, 0);
+    tree->nodeDistribution.assign((long) nnodes * tree->ndistribution, 0);
+    if (nnodes > 0) printSupports(0, tree, cover);
+}
+
+void Query_Best::printSupports(int node, Tree *tree, RCover *cover) {
+    tree->nodeSamples[node] = cover->getSupport();
+    tree->nodeWeight[node] = cover->getWeight();
+    nodeDistribution(cover, &tree->nodeDistribution[(long) node * tree->ndistribution]);
+    if (tree->feature[node] < 0) return;
+
+    // the left child of the arrays is the positive outcome
+    cover->intersect(tree->feature[node]);
+    printSupports(tree->left[node], tree, cover);
+    cover->backtrack();
+    cover->intersect(tree->feature[node], false);
+    printSupports(tree->right[node], tree, cover);
+    cover->backtrack();
+}
+
+void Query_Best::nodeDistribution(RCover *cover, float *distribution) {
+    Supports supports = cover->getSupportPerClass();
+    forEachClass(n) distribution[n] = supports[n];
+}
@@ -33,10 +33,15 @@ public:
                DataManager *data,
                int timeLimit,
                function<vector<float>(RCover *)> *tids_error_class_callback = nullptr,
-               function<vector<float>(RCover *)> *supports_error_class_callback = nullptr,
+               function<void(Supports, float *)> *supports_error_class_callback = nullptr,
                function<float(RCover *)> *tids_error_callback = nullptr,
                float maxError = NO_ERR,
-               bool stopAfterError = false);
+               bool stopAfterError = false,
+               NativeError *native_error = nullptr,
+               function<vector<float>(LeafBatch *)> *batch_error_class_callback = nullptr,
+               bool batch_on_supports = false,
+               LeafCache *leaf_cache = nullptr,
+               Error error_decrease_bound = 0);
 
     virtual ~Query_Best();
 
@@ -48,17 +53,33 @@ public:
         return floatEqual(((QueryData_Best *) actualBest)->error, ((QueryData_Best *) actualBest)->lowerBound);
     }
 
-    void printResult(Tree *tree);
+    void printResult(Tree *tree, RCover *cover);
 
 //    virtual void printTimeOut(Tree* tree );
-    void printResult(QueryData_Best *data, Tree *tree);
+    void printResult(QueryData_Best *data, Tree *tree, RCover *cover);
+
+    /**
+     * printSupports - fill the number of transactions, the weight and the distribution of each node of the tree found
+     * (see Tree) by following its branches with the cover, which must be the cover of the root
+     */
+    void printSupports(Tree *tree, RCover *cover);
 
     inline QueryData_Best *rootBest() const { return (QueryData_Best *) realroot->data; }
 
     virtual Error getTrainingError(const string &tree_json) {}
 
 protected:
-    int printResult(QueryData_Best *node_data, int depth, Tree *tree);
+    virtual int printResult(QueryData_Best *node_data, int depth, Tree *tree);
+
+    /// the number of values predicted by each leaf
+    virtual int nLeafValues() { return 1; }
+
+    /// the distribution of the transactions of the current cover: the supports of the classes by default
+    virtual int nDistributionValues() { return nclasses; }
+
+    virtual void nodeDistribution(RCover *cover, float *distribution);
+
+    void printSupports(int node, Tree *tree, RCover *cover);
 
 };
 
@@ -0,0 +1,97 @@
+#include "query_multitarget.h"
+#include <climits>
+#include <stdexcept>
+
+Query_MultiTarget::Query_MultiTarget(Support minsup,
+                                     Depth maxdepth,
+                                     Trie *trie,
+                                     DataManager *data,
+                                     int timeLimit,
+                                     const vector<int> &target_offsets,
+                                     const float *target_weights,
+                                     float maxError,
+                                     bool stopAfterError) :
+        Query_TotalFreq(minsup,
+                        maxdepth,
+                        trie,
+                        data,
+                        timeLimit,
+                        nullptr,
+                        nullptr,
+                        nullptr,
+                        maxError,
+                        stopAfterError),
+        target_offsets(target_offsets) {
+    int ntargets = (int) target_offsets.size() - 1;
+    if (target_weights) this->target_weights.assign(target_weights, target_weights + ntargets);
+    else this->target_weights.assign(ntargets, 1);
+
+    // the classes of a leaf are encoded in the class of the node
+    long long ncombinations = 1;
+    for (int t = 0; t < ntargets; ++t) {
+        ncombinations *= target_offsets[t + 1] - target_offsets[t];
+        if (ncombinations > INT_MAX) throw invalid_argument("Too many combinations of classes of the targets");
+    }
+}
+
+
+Query_MultiTarget::~Query_MultiTarget() {}
+
+LeafInfo Query_MultiTarget::computeLeafInfo(RCover *cover) {
+    return computeLeafInfo(cover->getSupportPerClass());
+}
+
+/**
+ * computeLeafInfo - find the majority class of each target. As for a single target, ties are broken in favour of the
+ * class with the highest support in the dataset
+ * @param itemsetSupport - the supports per class of all the targets
+ * @return the weighted sum of the errors of the targets and the code of their classes
+ */
+LeafInfo Query_MultiTarget::computeLeafInfo(Supports itemsetSupport) {
+    Error error = 0;
+    Class code = 0;
+    int radix = 1;
+    for (int t = 0; t + 1 < (int) target_offsets.size(); ++t) {
+        int first = target_offsets[t], n = target_offsets[t + 1] - first;
+        Class maxclass = first;
+        SupportClass maxclassval = itemsetSupport[first], sum = itemsetSupport[first];
+        for (int i = first + 1; i < first + n; ++i) {
+            sum += itemsetSupport[i];
+            if (itemsetSupport[i] > maxclassval) {
+                maxclassval = itemsetSupport[i];
+                maxclass = i;
+            } else if (floatEqual(itemsetSupport[i], maxclassval)) {
+                if (dm->getSupports()[i] > dm->getSupports()[maxclass])
+                    maxclass = i;
+            }
+        }
+        error += target_weights[t] * (sum - maxclassval);
+        code += (maxclass - first) * radix;
+        radix *= n;
+    }
+    return {error, code, 0};
+}
+
+// a transaction changes the error of each target by one at most
+Error Query_MultiTarget::maxErrorPerUnit() {
+    Error sum = 0;
+    for (float weight : target_weights) sum += weight;
+    return sum;
+}
+
+// the value of a leaf is the list of the classes of the targets
+int Query_MultiTarget::printResult(QueryData_Best *data, int depth, Tree *tree) {
+    if (data->left) return Query_Best::printResult(data, depth, tree);
+    int node = tree->addNode(-1, data->error);
+    tree->expression += "{\"value\": [";
+    Class code = data->test;
+    for (int t = 0; t + 1 < (int) target_offsets.size(); ++t) {
+        int n = target_offsets[t + 1] - target_offsets[t];
+        if (t > 0) tree->expression += ", ";
+        tree->expression += std::to_string(code % n);
+        tree->value[node * tree->nvalues + t] = code % n;
+        code /= n;
+    }
+    tree->expression += "], \"error\": " + std::to_string(data->error);
+    return depth;
+}
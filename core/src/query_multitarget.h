@@ -0,0 +1,46 @@
+#ifndef QUERY_MULTITARGET_H
+#define QUERY_MULTITARGET_H
+
+#include <query_totalfreq.h>
+#include <vector>
+
+/**
+ * Query_MultiTarget - the query of the classification trees predicting several targets at once. The classes of all
+ * the targets are the classes of the data manager, stored side by side, so the supports per class of all the targets
+ * are counted in the same pass over the cover. The error of a leaf is the weighted sum of the misclassification
+ * errors of the targets. The class of a leaf encodes the classes of all the targets in a mixed radix number
+ * @param target_offsets - the first class of each target, followed by the total number of classes
+ * @param target_weights - the weight of the error of each target
+ */
+class Query_MultiTarget : public Query_TotalFreq {
+public:
+    Query_MultiTarget(Support minsup,
+                      Depth maxdepth,
+                      Trie *trie,
+                      DataManager *data,
+                      int timeLimit,
+                      const vector<int> &target_offsets,
+                      const float *target_weights = nullptr,
+                      float maxError = NO_ERR,
+                      bool stopAfterError = false);
+
+    ~Query_MultiTarget();
+
+    LeafInfo computeLeafInfo(RCover *cover);
+
+    LeafInfo computeLeafInfo(Supports itemsetSupport);
+
+    Error maxErrorPerUnit();
+
+    using Query_Best::printResult;
+
+    vector<int> target_offsets;
+    vector<float> target_weights;
+
+protected:
+    int printResult(QueryData_Best *node_data, int depth, Tree *tree);
+
+    int nLeafValues() { return (int) target_offsets.size() - 1; }
+};
+
+#endif
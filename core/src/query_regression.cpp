@@ -0,0 +1,89 @@
+#include "query_regression.h"
+
+Query_Regression::Query_Regression(Support minsup,
+                                   Depth maxdepth,
+                                   Trie *trie,
+                                   DataManager *data,
+                                   int timeLimit,
+                                   RCoverRegression *cover,
+                                   RegressionCriterion criterion,
+                                   float maxError,
+                                   bool stopAfterError) :
+        Query_TotalFreq(minsup,
+                        maxdepth,
+                        trie,
+                        data,
+                        timeLimit,
+                        nullptr,
+                        nullptr,
+                        nullptr,
+                        maxError,
+                        stopAfterError),
+        cover(cover),
+        criterion(criterion) {}
+
+
+Query_Regression::~Query_Regression() {}
+
+LeafInfo Query_Regression::computeLeafInfo(RCover *cover) {
+    if (criterion == MAE_CRITERION) return {((RCoverRegression *) cover)->getMedian().second, -1, 0};
+    return computeLeafInfo(cover->getSupportPerClass());
+}
+
+// the squared error is derived from the weight, the sums and the sum of squares of the targets. Only the additive
+// criterion reaches this function since the depth two algorithm is disabled for the others
+LeafInfo Query_Regression::computeLeafInfo(Supports itemsetSupport) {
+    if (itemsetSupport[0] <= 0) return {0, -1, 0};
+    int ntargets = cover->ntargets;
+    double error = itemsetSupport[ntargets + 1];
+    for (int f = 1; f <= ntargets; ++f) error -= (double) itemsetSupport[f] * itemsetSupport[f] / itemsetSupport[0];
+    // the subtraction of close sums may be slightly negative
+    return {(error > 0) ? (Error) error : 0, -1, 0};
+}
+
+// the values of the leaf represented by the current cover, one per target
+vector<float> Query_Regression::leafValues() {
+    if (criterion == MAE_CRITERION) return vector<float>(1, cover->getMedian().first + cover->offset[0]);
+    Supports stats = cover->getSupportPerClass();
+    vector<float> values(cover->ntargets);
+    for (int f = 0; f < cover->ntargets; ++f) values[f] = stats[f + 1] / max(stats[0], FLT_MIN) + cover->offset[f];
+    return values;
+}
+
+void Query_Regression::nodeDistribution(RCover *, float *distribution) {
+    vector<float> values = leafValues();
+    copy(values.begin(), values.end(), distribution);
+}
+
+// the cover follows the branches of the tree to compute the value of each leaf. It is a list when there are several
+int Query_Regression::printResult(QueryData_Best *data, int depth, Tree *tree) {
+    int node = tree->addNode((data->left) ? data->test : -1, data->error);
+    if (!data->left) { // leaf
+        vector<float> values = leafValues();
+        string value = (values.size() > 1) ? "[" : "";
+        for (int f = 0; f < (int) values.size(); ++f) {
+            if (f > 0) value += ", ";
+            value += std::to_string(values[f]);
+            tree->value[node * tree->nvalues + f] = values[f];
+        }
+        if (values.size() > 1) value += "]";
+        tree->expression += "{\"value\": " + value + ", \"error\": " + std::to_string(data->error);
+        return depth;
+    }
+    else {
+        tree->expression += "{\"feat\": " + std::to_string(data->test) + ", \"left\": ";
+
+        // the positive outcome is stored in right
+        tree->left[node] = (int) tree->feature.size();
+        cover->intersect(data->test);
+        int left_depth = printResult(data->right, depth + 1, tree);
+        cover->backtrack();
+        tree->expression += "}, \"right\": ";
+        tree->right[node] = (int) tree->feature.size();
+        cover->intersect(data->test, false);
+        int right_depth = printResult(data->left, depth + 1, tree);
+        cover->backtrack();
+        tree->expression += "}";
+        return max(left_depth, right_depth);
+    }
+}
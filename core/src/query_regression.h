@@ -0,0 +1,60 @@
+#ifndef QUERY_REGRESSION_H
+#define QUERY_REGRESSION_H
+
+#include <query_totalfreq.h>
+#include "rCoverRegression.h"
+#include <vector>
+
+// the error minimized by the regression trees
+enum RegressionCriterion {
+    MSE_CRITERION = 0, // sum of the squared errors; the leaves predict the mean of their targets
+    MAE_CRITERION = 1  // sum of the absolute errors; the leaves predict the median of their targets
+};
+
+/**
+ * Query_Regression - the query of the regression trees and of the clustering trees, seen as regression trees whose
+ * targets are the features of the examples. The leaf errors are computed from the statistics of the cover (see
+ * RCoverRegression) for the squared error, and from the targets of the covered transactions for the absolute error.
+ * The leaf values (the mean or the median of the targets) are computed when the tree is printed
+ */
+class Query_Regression : public Query_TotalFreq {
+public:
+    Query_Regression(Support minsup,
+                     Depth maxdepth,
+                     Trie *trie,
+                     DataManager *data,
+                     int timeLimit,
+                     RCoverRegression *cover,
+                     RegressionCriterion criterion = MSE_CRITERION,
+                     float maxError = NO_ERR,
+                     bool stopAfterError = false);
+
+    ~Query_Regression();
+
+    LeafInfo computeLeafInfo(RCover *cover);
+
+    LeafInfo computeLeafInfo(Supports itemsetSupport);
+
+    bool isAdditive() { return criterion == MSE_CRITERION; }
+
+    Error maxErrorPerUnit() { return (criterion == MSE_CRITERION) ? cover->range * cover->range : cover->range; }
+
+    using Query_Best::printResult;
+
+    RCoverRegression *cover;
+    RegressionCriterion criterion;
+
+protected:
+    vector<float> leafValues();
+
+    int printResult(QueryData_Best *node_data, int depth, Tree *tree);
+
+    int nLeafValues() { return (criterion == MSE_CRITERION) ? cover->ntargets : 1; }
+
+    // the distribution of a node is the value it would predict as a leaf
+    int nDistributionValues() { return nLeafValues(); }
+
+    void nodeDistribution(RCover *cover, float *distribution);
+};
+
+#endif
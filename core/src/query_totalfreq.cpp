@@ -1,5 +1,7 @@
 #include "query_totalfreq.h"
 #include "trie.h"
+#include "nativeError.h"
+#include "leafCache.h"
 #include <iostream>
 
 Query_TotalFreq::Query_TotalFreq(Support minsup,
@@ -8,9 +10,14 @@ Query_TotalFreq::Query_TotalFreq(Support minsup,
                                  DataManager *data,
                                  int timeLimit,
                                  function<vector<float>(RCover *)> *tids_error_class_callback,
-                                 function<vector<float>(RCover *)> *supports_error_class_callback,
+                                 function<void(Supports, float *)> *supports_error_class_callback,
                                  function<float(RCover *)> *tids_error_callback,
-                                 float maxError, bool stopAfterError) :
+                                 float maxError, bool stopAfterError, NativeError *native_error,
+                                 function<vector<float>(LeafBatch *)> *batch_error_class_callback,
+                                 bool batch_on_supports,
+                                 LeafCache *leaf_cache,
+                                 const float *cost_matrix,
+                                 Error error_decrease_bound) :
         Query_Best(minsup,
                    maxdepth,
                    trie,
@@ -20,7 +27,14 @@ Query_TotalFreq::Query_TotalFreq(Support minsup,
                    supports_error_class_callback,
                    tids_error_callback,
                    (maxError <= 0) ? NO_ERR : maxError,
-                   (maxError <= 0) ? false : stopAfterError) {}
+                   (maxError <= 0) ? false : stopAfterError,
+                   native_error,
+                   batch_error_class_callback,
+                   batch_on_supports,
+                   leaf_cache,
+                   error_decrease_bound) {
+    if (cost_matrix) this->cost_matrix.assign(cost_matrix, cost_matrix + nclasses * nclasses);
+}
 
 
 Query_TotalFreq::~Query_TotalFreq() {}
@@ -57,48 +71,69 @@ bool Query_TotalFreq::updateData(QueryData *best, Error upperBound, Attribute at
 }
 
 QueryData *Query_TotalFreq::initData(RCover *cover, Depth currentMaxDepth) {
-    Class maxclass = -1;
-    Error error;
-
-    auto *data = new QueryData_Best();
+    LeafInfo ev = {NO_ERR, -1, 0};
+
+    // the python error function may have already been called on the same cover reached through another itemset
+    string cache_key;
+    if (leaf_cache != nullptr) {
+        LeafInfo cached;
+        cache_key = leafCacheKey(cover);
+        if (leaf_cache->find(cache_key, cached)) return initData(cached);
+    }
 
+    //python batch error. A node which has not been evaluated with its siblings is evaluated as a batch of one leaf
+    if (batch_error_class_callback != nullptr) {
+        LeafBatch batch(batch_on_supports);
+        batch.add(cover);
+        ev = computeBatchLeafInfo(&batch)[0];
+    }
     //fast or default error. support will be used
-    if (tids_error_class_callback == nullptr && tids_error_callback == nullptr) {
+    else if (tids_error_class_callback == nullptr && tids_error_callback == nullptr) {
         //python fast error
         if (supports_error_class_callback != nullptr) {
-            function<vector<float>(RCover *)> callback = *supports_error_class_callback;
-            cover->getSupportPerClass(); // allocate the sup_array if it does not exist yet and compute the frequency counts
-            vector<float> infos = callback(cover);
-            error = infos[0];
-            maxclass = int(infos[1]);
-        }
-        //default error
-        else {
-            LeafInfo ev = computeLeafInfo(cover);
-            error = ev.error;
-            maxclass = ev.maxclass;
+            float infos[3] = {NO_ERR, -1, 0};
+            StatsTimer timer(stats.callbackTime);
+            (*supports_error_class_callback)(cover->getSupportPerClass(), infos);
+            ev = {infos[0], int(infos[1]), infos[2]};
         }
+        //default or native error
+        else ev = computeLeafInfo(cover);
     }
     //slow error or predictor error function. Not need to compute support
     else {
+        StatsTimer timer(stats.callbackTime);
         if (tids_error_callback != nullptr) {
             function<float(RCover *)> callback = *tids_error_callback;
-            error = callback(cover);
+            ev.error = callback(cover);
         } else {
             function<vector<float>(RCover *)> callback = *tids_error_class_callback;
             vector<float> infos = callback(cover);
-            error = infos[0];
-            maxclass = int(infos[1]);
+            ev = {infos[0], int(infos[1]), (infos.size() > 2) ? infos[2] : 0};
         }
     }
-    data->test = maxclass;
-    data->leafError = error;
-    data->error += error;
+    if (leaf_cache != nullptr) leaf_cache->insert(cache_key, ev);
+    return initData(ev);
+}
+
+QueryData *Query_TotalFreq::initData(LeafInfo leafInfo) {
+    auto *data = new QueryData_Best();
+    data->test = leafInfo.maxclass;
+    data->leafError = leafInfo.error;
+    data->error += leafInfo.error;
+    // the lower bound given by a custom error. No tree can do better than a leaf
+    if (leafInfo.lowerBound > 0) data->lowerBound = min(leafInfo.lowerBound, leafInfo.error);
 
     return (QueryData *) data;
 }
 
 LeafInfo Query_TotalFreq::computeLeafInfo(RCover *cover) {
+    // the native error needs the transactions only when it cannot use the supports
+    if (native_error) {
+        if (native_error->isAdditive()) return native_error->leafErrorFromSupports(cover->getSupportPerClass());
+        return native_error->leafError(cover);
+    }
+    if (!cost_matrix.empty()) return computeCostLeafInfo(cover->getSupportPerClass());
+
     Class maxclass;
     Error error;
 
@@ -116,11 +151,14 @@ LeafInfo Query_TotalFreq::computeLeafInfo(RCover *cover) {
         }
     }
     error = sumSupports(itemsetSupport) - maxclassval;
-    return {error, maxclass};
+    return {error, maxclass, 0};
 }
 
 
 LeafInfo Query_TotalFreq::computeLeafInfo(Supports itemsetSupport) {
+    if (native_error) return native_error->leafErrorFromSupports(itemsetSupport);
+    if (!cost_matrix.empty()) return computeCostLeafInfo(itemsetSupport);
+
     Class maxclass = 0;
     Error error;
     SupportClass maxclassval = itemsetSupport[0];
@@ -135,5 +173,32 @@ LeafInfo Query_TotalFreq::computeLeafInfo(Supports itemsetSupport) {
         }
     }
     error = sumSupports(itemsetSupport) - maxclassval;
-    return {error, maxclass};
+    return {error, maxclass, 0};
+}
+
+/**
+ * computeCostLeafInfo - find the class whose prediction has the lowest total cost given the supports per class of a
+ * leaf. Ties are broken in favour of the class with the highest support in the dataset as for the misclassification
+ * @param itemsetSupport - the supports per class of the leaf
+ * @return the total cost and the predicted class
+ */
+LeafInfo Query_TotalFreq::computeCostLeafInfo(Supports itemsetSupport) {
+    Class maxclass = 0;
+    Error error = FLT_MAX;
+    for (int predicted = 0; predicted < nclasses; ++predicted) {
+        Error cost = 0;
+        forEachClass(actual) cost += itemsetSupport[actual] * cost_matrix[actual * nclasses + predicted];
+        if (cost < error && !floatEqual(cost, error)) {
+            error = cost;
+            maxclass = predicted;
+        } else if (floatEqual(cost, error) && dm->getSupports()[predicted] > dm->getSupports()[maxclass])
+            maxclass = predicted;
+    }
+    return {error, maxclass, 0};
+}
+
+// removing a transaction from a leaf decreases its cost by at most the highest cost of the matrix
+Error Query_TotalFreq::maxErrorPerUnit() {
+    if (cost_matrix.empty()) return Query::maxErrorPerUnit();
+    return *max_element(cost_matrix.begin(), cost_matrix.end());
 }
@@ -12,10 +12,16 @@ public:
                     DataManager *data,
                     int timeLimit,
                     function<vector<float>(RCover *)> *tids_error_class_callback = nullptr,
-                    function<vector<float>(RCover *)> *supports_error_class_callback = nullptr,
+                    function<void(Supports, float *)> *supports_error_class_callback = nullptr,
                     function<float(RCover *)> *tids_error_callback = nullptr,
                     float maxError = NO_ERR,
-                    bool stopAfterError = false);
+                    bool stopAfterError = false,
+                    NativeError *native_error = nullptr,
+                    function<vector<float>(LeafBatch *)> *batch_error_class_callback = nullptr,
+                    bool batch_on_supports = false,
+                    LeafCache *leaf_cache = nullptr,
+                    const float *cost_matrix = nullptr,
+                    Error error_decrease_bound = 0);
 
     ~Query_TotalFreq();
 
@@ -27,11 +33,18 @@ public:
 
     QueryData *initData(RCover *tid, Depth currentMaxDepth = -1);
 
+    QueryData *initData(LeafInfo leafInfo);
+
     LeafInfo computeLeafInfo(RCover *cover);
 
     LeafInfo computeLeafInfo(Supports itemsetSupport);
 
+    Error maxErrorPerUnit();
+
+    vector<float> cost_matrix; // cost of predicting the column class for an example of the row class. Empty for the misclassification
+
 protected:
+    LeafInfo computeCostLeafInfo(Supports itemsetSupport);
 };
 
 #endif
\ No newline at end of file
@@ -86,6 +86,7 @@ Support RCover::temporaryIntersectSup(Attribute attribute, bool positive) {
         else word = coverWords[validWords[i]].top() & ~(dm->getAttributeCover(attribute)[validWords[i]]);
         sup += word.count();
     }
+    if (trace) trace->temporaryIntersectSup(attribute, positive, sup);
     return sup;
 }
 
@@ -138,19 +139,23 @@ Support RCover::temporaryIntersectSup(Attribute attribute, bool positive) {
 }*/
 Supports RCover::minusMe(bitset<M>* cover1) {
     int maxValidNumber = limit.top();
+    // the words of the difference are stored since getSupportPerClass reads them through pointers
+    bitset<M>* difwords = new bitset<M>[maxValidNumber];
     bitset<M>** difcover = new bitset<M>*[maxValidNumber];
     int* validIndexes = new int[maxValidNumber];
     int nvalid = 0;
     for (int i = 0; i < maxValidNumber; ++i) {
         bitset<M> potential_word = cover1[validWords[i]] & ~coverWords[validWords[i]].top();
         if (!potential_word.none()){
-            difcover[nvalid] = &potential_word;
+            difwords[nvalid] = potential_word;
+            difcover[nvalid] = &difwords[nvalid];
             validIndexes[nvalid] = validWords[i];
             ++nvalid;
         }
     }
 
     Supports toreturn = getSupportPerClass(difcover, nvalid, validIndexes);
+    delete [] difwords;
     delete [] difcover;
     delete [] validIndexes;
     return toreturn;
@@ -167,6 +172,60 @@ SupportClass RCover::countDif(bitset<M>* cover1) {
     return sup;
 }
 
+/**
+ * getFirstSetBitPos - get the index of the first bit set in a binary number
+ * remember that index goes from right to left and the first index is 1
+ * @param number - int value of the binary number
+ * @return the index of the first set bit
+ */
+unsigned int getFirstSetBitPos(const u_long& number) { return log2(number & -number) + 1;}
+
+/**
+ * getTransactionsID
+ * @return the list of transactions in the current cover
+ */
+vector<int> RCover::getTransactionsID() {
+    vector<int> tid;
+    for (int i = 0; i < limit.top(); ++i) {
+        int indexForTransactions = nWords - (validWords[i]+1);
+        bitset<M> word = coverWords[validWords[i]].top();
+        u_long w = word.to_ulong();
+        int pos = getFirstSetBitPos(w);
+        int transInd = pos - 1;
+        while (pos >= 1){
+            tid.push_back(indexForTransactions * M + transInd);
+            word = (word >> pos);
+            w = word.to_ulong();
+            pos = getFirstSetBitPos(w);
+            transInd += pos;
+        }
+    }
+    return tid;
+}
+
+// mix the bits of a 64 bits value (finalizer of splitmix64)
+inline unsigned long long mix64(unsigned long long x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * fingerprint - compute a 128 bits hash of the current cover. Two different covers get the same fingerprint with a
+ * negligible probability. The hash does not depend on the order of the valid words
+ * @return the two 64 bits halves of the hash
+ */
+pair<unsigned long long, unsigned long long> RCover::fingerprint() {
+    unsigned long long h1 = 0, h2 = 0;
+    for (int i = 0; i < limit.top(); ++i) {
+        unsigned long long word = coverWords[validWords[i]].top().to_ullong();
+        auto position = (unsigned long long) validWords[i];
+        h1 += mix64(word ^ mix64(position));
+        h2 += mix64(mix64(word) + 0x9e3779b97f4a7c15ULL * (position + 1));
+    }
+    return make_pair(h1, h2);
+}
+
 int RCover::getSupport() {
     if (support > -1) return support;
     int sum = 0;
@@ -177,6 +236,13 @@ int RCover::getSupport() {
     return sum;
 }
 
+SupportClass RCover::getWeight() {
+    SupportClass weight = 0;
+    for (int i = 0; i < limit.top(); ++i)
+        weight += countSupportClass(coverWords[validWords[i]].top(), validWords[i]);
+    return weight;
+}
+
 void RCover::backtrack() {
     limit.pop();
     int climit = limit.top();
@@ -186,6 +252,24 @@ void RCover::backtrack() {
     support = -1;
     deleteSupports(sup_class);
     sup_class = nullptr;
+    if (trace) trace->backtrack();
+}
+
+void RCover::restrictRoot(const bitset<M> *mask) {
+    if (trace) trace->restrictRoot(mask);
+    int climit = limit.top();
+    for (int i = 0; i < climit; ++i) {
+        coverWords[validWords[i]].top() &= mask[validWords[i]];
+        if (coverWords[validWords[i]].top().none()) {
+            swap(validWords[i], validWords[climit - 1]);
+            --climit;
+            --i;
+        }
+    }
+    limit.top() = climit;
+    support = -1;
+    deleteSupports(sup_class);
+    sup_class = nullptr;
 }
 
 void RCover::print() {
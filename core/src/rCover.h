@@ -12,6 +12,7 @@
 #include <utility>
 #include "globals.h"
 #include "dataManager.h"
+#include "searchTrace.h"
 #include <cmath>
 #include <algorithm>
 
@@ -19,6 +20,8 @@ using namespace std;
 
 #define M 64
 
+unsigned int getFirstSetBitPos(const u_long& number);
+
 class RCover {
 
 public:
@@ -29,6 +32,7 @@ public:
     DataManager* dm;
     Supports sup_class = nullptr;
     int support = -1;
+    SearchTrace* trace = nullptr; // the recorder of the operations, or null (see SearchTrace)
 
     RCover(DataManager* dmm, vector<float>* weights = nullptr);
 
@@ -54,6 +58,13 @@ public:
 
     Support getSupport();
 
+    // the total weight of the transactions of the cover, their number when they are not weighted
+    SupportClass getWeight();
+
+    vector<int> getTransactionsID();
+
+    pair<unsigned long long, unsigned long long> fingerprint();
+
     virtual Supports getSupportPerClass() = 0;
 
     virtual SupportClass countSupportClass(bitset<M>& coverWord, int wordIndex) = 0;
@@ -62,6 +73,13 @@ public:
 
     void backtrack();
 
+    /**
+     * restrictRoot - keep in the root cover only the transactions of a mask, so that the search only sees them. It
+     * must be called before any intersection
+     * @param mask - the nWords words of the transactions to keep, in the order of the cover words
+     */
+    void restrictRoot(const bitset<M> *mask);
+
     void print();
 
     string outprint();
@@ -0,0 +1,68 @@
+#include "rCoverRegression.h"
+#include <algorithm>
+
+RCoverRegression::RCoverRegression(DataManager *dmm, float* in_targets, int ntargets, vector<float>* weights):
+        RCoverStats<TargetMoments>(dmm, TargetMoments{dmm, ntargets, {}, weights}, weights), ntargets(ntargets),
+        targets(policy.targets), weights(weights) {
+    int ntransactions = dm->getNTransactions();
+    targets.assign(in_targets, in_targets + ntransactions * ntargets);
+    offset.assign(ntargets, 0);
+    double sum_weights = 0, squared_range = 0;
+    for (int i = 0; i < ntransactions; ++i) sum_weights += (weights) ? (*weights)[i] : 1;
+    for (int f = 0; f < ntargets; ++f) {
+        double sum = 0;
+        float min_target = FLT_MAX, max_target = -FLT_MAX;
+        for (int i = 0; i < ntransactions; ++i) {
+            float y = targets[i * ntargets + f];
+            sum += ((weights) ? (*weights)[i] : 1) * y;
+            min_target = min(min_target, y);
+            max_target = max(max_target, y);
+        }
+        if (sum_weights > 0) offset[f] = (float) (sum / sum_weights);
+        if (ntransactions > 0) squared_range += (double) (max_target - min_target) * (max_target - min_target);
+        for (int i = 0; i < ntransactions; ++i) targets[i * ntargets + f] -= offset[f];
+    }
+    range = (float) sqrt(squared_range);
+}
+
+/**
+ * getMedian - compute the weighted median of the (first) target of the current cover and the weighted sum of the
+ * absolute deviations of the targets from it
+ * @return a pair of the (shifted) median and the sum of absolute deviations
+ */
+pair<float, Error> RCoverRegression::getMedian() {
+    vector<pair<float, float>> values; // target and weight of each transaction
+    double total = 0;
+    for (int tid : getTransactionsID()) {
+        float w = (weights) ? (*weights)[tid] : 1;
+        values.emplace_back(targets[tid * ntargets], w);
+        total += w;
+    }
+    if (values.empty()) return make_pair(0.f, 0.f);
+
+    /* the median is the first value in increasing order whose cumulated weight reaches half the total. It is selected
+     without sorting the values: the range [first, last) holding it is partitioned around its middle value by
+     nth_element, and the weight of the values before the middle one tells in which part the median is. The expected
+     cost is linear in the size of the cover, the MAE being computed at each node */
+    auto first = values.begin(), last = values.end();
+    double before = 0; // the weight of the values before first
+    while (last - first > 1) {
+        auto middle = first + (last - first) / 2;
+        nth_element(first, middle, last);
+        double cumulated = before;
+        for (auto it = first; it != middle; ++it) cumulated += it->second;
+        if (cumulated >= total / 2) last = middle;
+        else if (cumulated + middle->second >= total / 2) {
+            first = middle;
+            break;
+        }
+        else {
+            before = cumulated + middle->second;
+            first = middle + 1;
+        }
+    }
+    float median = (first != values.end()) ? first->first : values.back().first;
+    double deviation = 0;
+    for (auto &value : values) deviation += value.second * fabs(value.first - median);
+    return make_pair(median, (Error) deviation);
+}
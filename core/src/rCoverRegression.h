@@ -0,0 +1,76 @@
+#ifndef RSBS_RCOVER_REGRESSION_H
+#define RSBS_RCOVER_REGRESSION_H
+
+#include "rCoverStats.h"
+
+// number of statistics stored per cover for a given number of targets: weight, sum of each target and sum of squares
+#define nstats(ntargets) ( ntargets + 2 )
+
+/**
+ * TargetMoments - the statistics policy of numerical targets: the (weighted) number of transactions, the sum of each
+ * target and the sum of the squared norms of the target vectors. Only the set bits of a word are visited
+ * @param ntargets - the number of targets of each transaction
+ * @param targets - the targets of the transactions (row by row)
+ * @param weights - the weights of the transactions. Null for unit weights
+ */
+struct TargetMoments {
+    DataManager *dm;
+    int ntargets;
+    vector<float> targets;
+    vector<float> *weights;
+
+    int size() const { return nstats(ntargets); }
+
+    void add(const bitset<M> &word, int wordIndex, int wordSupport, double *stats) const {
+        int first_tid = (dm->nWords - (wordIndex + 1)) * M;
+        for (unsigned long long bits = word.to_ullong(); bits; bits &= bits - 1) {
+            int tid = first_tid + lowestSetBit(bits);
+            double w = (weights) ? (*weights)[tid] : 1;
+            const float *y = &targets[tid * ntargets];
+            stats[0] += w;
+            for (int f = 0; f < ntargets; ++f) {
+                double wy = w * y[f];
+                stats[f + 1] += wy;
+                stats[ntargets + 1] += wy * y[f];
+            }
+        }
+    }
+
+    SupportClass weight(const bitset<M> &word, int wordIndex) const {
+        if (!weights) return word.count();
+        SupportClass sum = 0;
+        int first_tid = (dm->nWords - (wordIndex + 1)) * M;
+        for (unsigned long long bits = word.to_ullong(); bits; bits &= bits - 1)
+            sum += (*weights)[first_tid + lowestSetBit(bits)];
+        return sum;
+    }
+};
+
+/**
+ * RCoverRegression - a cover whose "supports per class" are the sufficient statistics of numerical targets (see
+ * TargetMoments). There is one target for the regression and one per feature for the clustering. The statistics are
+ * additive, so the statistics of a sibling can be obtained by subtraction from the parent as for the classes supports
+ * @param ntargets - the number of targets of each transaction
+ * @param targets - the targets of the transactions (row by row), shifted by offset to keep the sums of squares small
+ * @param offset - the weighted mean of each target on the whole dataset
+ * @param range - the diameter of the targets: the highest distance between two target vectors is at most range
+ * @param weights - the weights of the transactions. Null for unit weights
+ */
+class RCoverRegression : public RCoverStats<TargetMoments> {
+
+public:
+
+    RCoverRegression(DataManager* dmm, float* targets, int ntargets = 1, vector<float>* weights = nullptr);
+
+    ~RCoverRegression(){}
+
+    pair<float, Error> getMedian();
+
+    int ntargets;
+    vector<float> &targets;
+    vector<float> offset;
+    float range = 0;
+    vector<float>* weights;
+};
+
+#endif //RSBS_RCOVER_REGRESSION_H
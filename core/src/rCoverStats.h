@@ -0,0 +1,131 @@
+#ifndef RSBS_RCOVER_STATS_H
+#define RSBS_RCOVER_STATS_H
+
+#include "rCover.h"
+
+// index of the lowest set bit of a non-null word
+inline int lowestSetBit(unsigned long long word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int pos = 0;
+    while (!(word & 1ULL)) { word >>= 1; ++pos; }
+    return pos;
+#endif
+}
+
+/**
+ * RCoverStats - a cover whose "supports per class" are leaf statistics accumulated word by word by a compile-time
+ * policy. The loops over the words of the cover are written once here and the policy is inlined in them, so a new
+ * native objective only needs a policy (and a query computing the leaf error from the statistics). A policy provides:
+ *
+ *     int size() const; // the number of statistics, stored in the nclasses entries of the supports
+ *     void add(const bitset<M> &word, int wordIndex, int wordSupport, double *stats) const; // add the statistics of
+ *         // the transactions of a word of the cover. wordIndex is the index of the word in coverWords
+ *     SupportClass weight(const bitset<M> &word, int wordIndex) const; // the total weight of the transactions of a word
+ *
+ * The statistics must be additive: the statistics of the union of two disjoint covers are the sums of theirs. The depth
+ * two algorithm and the similarity lower bound rely on it to derive the statistics of a cover by subtraction
+ * @param policy - the policy accumulating the statistics
+ * @param stats_buffer - the accumulator of the statistics, in double precision
+ */
+template<class Policy>
+class RCoverStats : public RCover {
+
+public:
+
+    RCoverStats(DataManager *dmm, const Policy &policy, vector<float> *weights = nullptr) :
+            RCover(dmm, weights), policy(policy), stats_buffer(policy.size(), 0) {}
+
+    ~RCoverStats() {}
+
+    void intersect(Attribute attribute, bool positive = true) {
+        int climit = limit.top();
+        double *stats = stats_buffer.data();
+        support = 0;
+        for (int i = 0; i < climit; ++i) {
+            bitset<M> word;
+            if (positive) word = coverWords[validWords[i]].top() & dm->getAttributeCover(attribute)[validWords[i]];
+            else word = coverWords[validWords[i]].top() & ~(dm->getAttributeCover(attribute)[validWords[i]]);
+
+            coverWords[validWords[i]].push(word);
+
+            int word_sup = word.count();
+            support += word_sup;
+            if (word_sup > 0) policy.add(word, validWords[i], word_sup, stats);
+
+            if (word.none()) {
+                int tmp = validWords[climit - 1];
+                validWords[climit - 1] = validWords[i];
+                validWords[i] = tmp;
+                --climit;
+                --i;
+            }
+        }
+        limit.push(climit);
+        sup_class = toSupports(stats);
+        if (trace) trace->intersect(attribute, positive, support);
+    }
+
+    /**
+     * temporaryIntersect - compute a temporary intersection of the current cover with an item
+     * to get its support and statistics. No changes are performed in the current cover
+     * this function is only used to prepare data for computation of the specific algo for 2-depth trees
+     * @param attribute - the attribute to intersect with
+     * @param positive - the item of the attribute
+     * @return a pair of statistics and support
+     */
+    pair<Supports, Support> temporaryIntersect(Attribute attribute, bool positive = true) {
+        double *stats = stats_buffer.data();
+        Support sup = 0;
+        for (int i = 0; i < limit.top(); ++i) {
+            bitset<M> word;
+            if (positive) word = coverWords[validWords[i]].top() & dm->getAttributeCover(attribute)[validWords[i]];
+            else word = coverWords[validWords[i]].top() & ~(dm->getAttributeCover(attribute)[validWords[i]]);
+
+            int word_sup = word.count();
+            sup += word_sup;
+            if (word_sup > 0) policy.add(word, validWords[i], word_sup, stats);
+        }
+        if (trace) trace->temporaryIntersect(attribute, positive, sup);
+        return make_pair(toSupports(stats), sup);
+    }
+
+    Supports getSupportPerClass() {
+        if (sup_class != nullptr) return sup_class;
+        double *stats = stats_buffer.data();
+        for (int i = 0; i < limit.top(); ++i) {
+            const bitset<M> &word = coverWords[validWords[i]].top();
+            policy.add(word, validWords[i], word.count(), stats);
+        }
+        sup_class = toSupports(stats);
+        return sup_class;
+    }
+
+    Supports getSupportPerClass(bitset<M> **cover, int nValidWords, int *validIndexes) {
+        double *stats = stats_buffer.data();
+        for (int i = 0; i < nValidWords; ++i) policy.add(*cover[i], validIndexes[i], cover[i]->count(), stats);
+        return toSupports(stats);
+    }
+
+    SupportClass countSupportClass(bitset<M> &coverWord, int wordIndex) {
+        return policy.weight(coverWord, wordIndex);
+    }
+
+    Policy policy;
+
+protected:
+    // copy the accumulated statistics to a new supports array and reset the accumulator
+    Supports toSupports(double *stats) {
+        Supports sc = newSupports();
+        forEachClass(n) {
+            sc[n] = (SupportClass) stats[n];
+            stats[n] = 0;
+        }
+        return sc;
+    }
+
+    vector<double> stats_buffer;
+};
+
+#endif //RSBS_RCOVER_STATS_H
@@ -5,9 +5,29 @@
 #ifndef RSBS_RCOVER_TOTAL_FREQ_H
 #define RSBS_RCOVER_TOTAL_FREQ_H
 
-#include "rCover.h"
+#include "rCoverStats.h"
+
+/**
+ * ClassCounts - the statistics policy of the classification without weights: the number of transactions of each class.
+ * With two classes, the second count is deduced from the support of the word
+ */
+struct ClassCounts {
+    DataManager *dm;
+
+    int size() const { return nclasses; }
+
+    void add(const bitset<M> &word, int wordIndex, int wordSupport, double *stats) const {
+        if (nclasses == 2) {
+            int addzero = (word & dm->getClassCover(0)[wordIndex]).count();
+            stats[0] += addzero;
+            stats[1] += wordSupport - addzero;
+        } else forEachClass(n) stats[n] += (word & dm->getClassCover(n)[wordIndex]).count();
+    }
+
+    SupportClass weight(const bitset<M> &word, int wordIndex) const { return word.count(); }
+};
 
-class RCoverTotalFreq : public RCover {
+class RCoverTotalFreq : public RCoverStats<ClassCounts> {
 
 public:
 
@@ -15,16 +35,6 @@ public:
 
     ~RCoverTotalFreq(){}
 
-    void intersect(Attribute attribute, bool positive = true);
-
-    pair<Supports, Support> temporaryIntersect(Attribute attribute, bool positive = true);
-
-    Supports getSupportPerClass();
-
-    Supports getSupportPerClass(bitset<M>** cover, int nValidWords, int* validIndexes);
-
-    SupportClass countSupportClass(bitset<M>& coverWord, int wordIndex);
-
 };
 
 
@@ -5,34 +5,39 @@
 #ifndef RSBS_RCOVER_WEIGHTED_H
 #define RSBS_RCOVER_WEIGHTED_H
 
-#include "rCover.h"
+#include "rCoverStats.h"
+
+/**
+ * WeightedClassCounts - the statistics policy of the classification with weighted transactions: the total weight of
+ * the transactions of each class
+ */
+struct WeightedClassCounts {
+    DataManager *dm;
+    vector<float> *weights;
+
+    int size() const { return nclasses; }
+
+    void add(const bitset<M> &word, int wordIndex, int wordSupport, double *stats) const {
+        forEachClass(n) stats[n] += weight(word & dm->getClassCover(n)[wordIndex], wordIndex);
+    }
+
+    SupportClass weight(const bitset<M> &word, int wordIndex) const {
+        SupportClass sum = 0;
+        int first_tid = (dm->nWords - (wordIndex + 1)) * M;
+        for (unsigned long long bits = word.to_ullong(); bits; bits &= bits - 1)
+            sum += (*weights)[first_tid + lowestSetBit(bits)];
+        return sum;
+    }
+};
 
-class RCoverWeighted : public RCover {
+class RCoverWeighted : public RCoverStats<WeightedClassCounts> {
 
 public:
 
     RCoverWeighted(DataManager* dmm, vector<float>* weights);
 
-    RCoverWeighted(RCoverWeighted &&cover, vector<float>* weights);
-
     ~RCoverWeighted(){}
 
-    void intersect(Attribute attribute, bool positive = true);
-
-    pair<Supports, Support> temporaryIntersect(Attribute attribute, bool positive = true);
-
-    Supports getSupportPerClass();
-
-    Supports getSupportPerClass(bitset<M>** cover, int nValidWords, int* validIndexes);
-
-    SupportClass countSupportClass(bitset<M>& coverWord, int wordIndex);
-
-    vector<int> getTransactionsID(bitset<M>& word, int real_word_index);
-
-    pair<SupportClass, Support> getSups(bitset<M>& word, int real_word_index);
-
-    vector<int> getTransactionsID();
-
     vector<float>* weights;
 
 };
@@ -0,0 +1,89 @@
+#ifndef DL85_SEARCHSTATS_H
+#define DL85_SEARCHSTATS_H
+
+#include <chrono>
+#include <string>
+
+using namespace std;
+
+/**
+ * SearchStats - where the time of a search goes and how many nodes each rule prunes, to tune the options of the search
+ * per dataset. The statistics are collected in Query::stats during the search and returned with the tree (Tree::stats).
+ * The times are in seconds. Those of the short operations repeated in the loops of the search (intersectTime, cacheTime,
+ * boundTime) cost two clock reads per operation, as much as the operations themselves, so they are only measured when
+ * DL85_STATS_TIMERS is defined (a compile definition, set by the DL85_STATS_TIMERS option of CMakeLists.txt) and are 0
+ * otherwise. The times do not sum to the search time: the remaining is the recursion itself and the leaf errors
+ * computed in C++
+ * @param successorTime - the computation of the candidate attributes of the nodes (getSuccessors), including their
+ * information gain
+ * @param intersectTime - the intersections of the cover with the items of the children explored, and the backtracks
+ * @param depthTwoCountTime - the supports of the pairs of attributes counted by the depth two algorithm
+ * @param depthTwoSelectTime - the selection of the best tree of depth two from these supports
+ * @param cacheTime - the inserts of the itemsets in the trie
+ * @param boundTime - the similarity lower bounds and the bounds given by a previous search
+ * @param callbackTime - the calls of the python error functions
+ * @param depthTwoCalls - the number of trees of depth two computed
+ * @param cacheHits - the number of nodes whose optimal tree was already in the trie
+ * @param prunedInfeasible - the number of nodes not searched since their upper bound is not above their lower bound,
+ * including the infeasible trees of depth two
+ * @param prunedLowest - the number of nodes not split since their leaf error reaches their lower bound
+ * @param prunedCanSkip - the number of candidate attributes of a node not tried since the error of the node reached its
+ * lower bound (Query::canSkip)
+ * @param prunedMinsup - the number of candidate attributes of a node discarded since one of their children has less
+ * than minsup transactions
+ */
+struct SearchStats {
+    double successorTime = 0;
+    double intersectTime = 0;
+    double depthTwoCountTime = 0;
+    double depthTwoSelectTime = 0;
+    double cacheTime = 0;
+    double boundTime = 0;
+    double callbackTime = 0;
+    long long depthTwoCalls = 0;
+    long long cacheHits = 0;
+    long long prunedInfeasible = 0;
+    long long prunedLowest = 0;
+    long long prunedCanSkip = 0;
+    long long prunedMinsup = 0;
+
+    string to_str() const {
+        string out = "";
+        out += "SuccessorTime: " + to_string(successorTime) + "\n";
+        out += "IntersectTime: " + to_string(intersectTime) + "\n";
+        out += "DepthTwoCountTime: " + to_string(depthTwoCountTime) + "\n";
+        out += "DepthTwoSelectTime: " + to_string(depthTwoSelectTime) + "\n";
+        out += "CacheTime: " + to_string(cacheTime) + "\n";
+        out += "BoundTime: " + to_string(boundTime) + "\n";
+        out += "CallbackTime: " + to_string(callbackTime) + "\n";
+        out += "DepthTwoCalls: " + to_string(depthTwoCalls) + "\n";
+        out += "CacheHits: " + to_string(cacheHits) + "\n";
+        out += "PrunedInfeasible: " + to_string(prunedInfeasible) + "\n";
+        out += "PrunedLowest: " + to_string(prunedLowest) + "\n";
+        out += "PrunedCanSkip: " + to_string(prunedCanSkip) + "\n";
+        out += "PrunedMinsup: " + to_string(prunedMinsup) + "\n";
+        return out;
+    }
+};
+
+// adds the time elapsed from its creation to its destruction to a time of SearchStats
+class StatsTimer {
+public:
+    explicit StatsTimer(double &time) : time(time), start(chrono::steady_clock::now()) {}
+
+    ~StatsTimer() { time += chrono::duration<double>(chrono::steady_clock::now() - start).count(); }
+
+private:
+    double &time;
+    chrono::steady_clock::time_point start;
+};
+
+// times the rest of the scope in a time of SearchStats when DL85_STATS_TIMERS is defined, and compiles to nothing
+// otherwise. Used for the short operations repeated in the loops of the search
+#ifdef DL85_STATS_TIMERS
+#define DL85_STATS_TIME(time) StatsTimer stats_timer(time)
+#else
+#define DL85_STATS_TIME(time)
+#endif
+
+#endif //DL85_SEARCHSTATS_H
@@ -0,0 +1,163 @@
+#include "searchTrace.h"
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+static const char TRACE_MAGIC[] = "DL85TRC";
+static const unsigned char TRACE_VERSION = 1;
+
+SearchTrace::SearchTrace(const string &path, DataManager *dm, const vector<float> *weights) : nWords(dm->nWords) {
+    file = fopen(path.c_str(), "wb");
+    if (!file) throw runtime_error("Cannot write the trace " + path);
+    int nclasses = (dm->hasClasses()) ? dm->getNClasses() : 0;
+    int header[] = {dm->getNTransactions(), dm->getNAttributes(), nclasses, (weights) ? (int) weights->size() : 0};
+    fwrite(TRACE_MAGIC, 1, sizeof(TRACE_MAGIC) - 1, file);
+    fwrite(&TRACE_VERSION, 1, 1, file);
+    fwrite(header, sizeof(int), 4, file);
+    for (int i = 0; i < dm->getNAttributes(); ++i) fwrite(dm->getAttributeCover(i), sizeof(bitset<M>), nWords, file);
+    for (int i = 0; i < nclasses; ++i) fwrite(dm->getClassCover(i), sizeof(bitset<M>), nWords, file);
+    if (weights) fwrite(weights->data(), sizeof(float), weights->size(), file);
+}
+
+SearchTrace::~SearchTrace() {
+    close();
+}
+
+void SearchTrace::restrictRoot(const bitset<M> *mask) {
+    event(TRACE_RESTRICT_ROOT);
+    for (int j = 0; j < nWords; ++j) putVarint(mask[j].to_ullong());
+}
+
+void SearchTrace::cacheEvent(TraceOp op, const Array<Item> &itemset, bool hit) {
+    event(op);
+    buffer.push_back(hit);
+    putVarint(itemset.size);
+    Item previous = 0;
+    for (int i = 0; i < itemset.size; ++i) {
+        long long delta = (long long) itemset.elts[i] - previous;
+        putVarint((unsigned long long) ((delta << 1) ^ (delta >> 63)));
+        previous = itemset.elts[i];
+    }
+}
+
+void SearchTrace::flush() {
+    if (file && !buffer.empty()) fwrite(buffer.data(), 1, buffer.size(), file);
+    buffer.clear();
+}
+
+void SearchTrace::close() {
+    if (!file) return;
+    flush();
+    fclose(file);
+    file = nullptr;
+}
+
+// a reader of the bytes of a trace which throws at the end of the data
+struct TraceInput {
+    const vector<unsigned char> &bytes;
+    size_t pos = 0;
+
+    explicit TraceInput(const vector<unsigned char> &bytes) : bytes(bytes) {}
+
+    void read(void *dest, size_t n) {
+        if (pos + n > bytes.size()) throw runtime_error("The trace is truncated");
+        memcpy(dest, bytes.data() + pos, n);
+        pos += n;
+    }
+
+    unsigned char byte() {
+        if (pos >= bytes.size()) throw runtime_error("The trace is truncated");
+        return bytes[pos++];
+    }
+
+    unsigned long long varint() {
+        unsigned long long value = 0;
+        for (int shift = 0;; shift += 7) {
+            unsigned char b = byte();
+            value |= (unsigned long long) (b & 0x7f) << shift;
+            if (!(b & 0x80)) return value;
+        }
+    }
+};
+
+// the int column of a packed cover, the inverse of DataManager::packColumn
+static void unpackColumn(const bitset<M> *words, int ntransactions, int value, int *column) {
+    int nWords = (int) ceil((float) ntransactions / M);
+    for (int t = 0; t < ntransactions; ++t)
+        if (words[nWords - (t / M + 1)][t % M]) column[t] = value;
+}
+
+void readTrace(const string &path, TraceData &trace) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) throw runtime_error("Cannot read the trace " + path);
+    vector<unsigned char> bytes;
+    unsigned char chunk[1 << 16];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) bytes.insert(bytes.end(), chunk, chunk + n);
+    fclose(file);
+
+    TraceInput in(bytes);
+    char magic[sizeof(TRACE_MAGIC)] = {0};
+    in.read(magic, sizeof(TRACE_MAGIC) - 1);
+    if (strcmp(magic, TRACE_MAGIC) != 0 || in.byte() != TRACE_VERSION)
+        throw runtime_error(path + " is not a search trace of this version");
+    int header[4];
+    in.read(header, sizeof(header));
+    trace.ntransactions = header[0];
+    trace.nattributes = header[1];
+    trace.nclasses = header[2];
+    int nWords = (int) ceil((float) trace.ntransactions / M);
+
+    vector<bitset<M>> words(nWords);
+    trace.data.assign((size_t) trace.ntransactions * trace.nattributes, 0);
+    for (int i = 0; i < trace.nattributes; ++i) {
+        in.read(words.data(), nWords * sizeof(bitset<M>));
+        unpackColumn(words.data(), trace.ntransactions, 1, trace.data.data() + (size_t) i * trace.ntransactions);
+    }
+    // the transactions of a search without classes (a regression) are given the class 0
+    trace.target.assign(trace.ntransactions, 0);
+    for (int c = 0; c < trace.nclasses; ++c) {
+        in.read(words.data(), nWords * sizeof(bitset<M>));
+        unpackColumn(words.data(), trace.ntransactions, c, trace.target.data());
+    }
+    trace.weights.resize(header[3]);
+    in.read(trace.weights.data(), trace.weights.size() * sizeof(float));
+
+    while (in.pos < bytes.size()) {
+        TraceEvent event{(TraceOp) in.byte(), NO_ATTRIBUTE, false, false, 0, 0, 0};
+        switch (event.op) {
+            case TRACE_INTERSECT:
+            case TRACE_TEMPORARY_INTERSECT:
+            case TRACE_TEMPORARY_INTERSECT_SUP: {
+                Item item = (Item) in.varint();
+                event.attribute = item_attribute(item);
+                event.positive = item_value(item);
+                event.support = (Support) in.varint();
+                break;
+            }
+            case TRACE_BACKTRACK:
+                break;
+            case TRACE_RESTRICT_ROOT:
+                event.offset = (int) trace.masks.size();
+                event.size = nWords;
+                for (int j = 0; j < nWords; ++j) trace.masks.push_back(bitset<M>(in.varint()));
+                break;
+            case TRACE_CACHE_INSERT:
+            case TRACE_CACHE_FIND: {
+                event.hit = in.byte() != 0;
+                event.offset = (int) trace.items.size();
+                event.size = (int) in.varint();
+                Item previous = 0;
+                for (int i = 0; i < event.size; ++i) {
+                    unsigned long long zigzag = in.varint();
+                    previous += (Item) ((long long) (zigzag >> 1) ^ -(long long) (zigzag & 1));
+                    trace.items.push_back(previous);
+                }
+                break;
+            }
+            default:
+                throw runtime_error("Unknown event in the trace " + path);
+        }
+        trace.events.push_back(event);
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef DL85_SEARCH_TRACE_H
+#define DL85_SEARCH_TRACE_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "globals.h"
+#include "dataManager.h"
+
+using namespace std;
+
+/**
+ * TraceOp - the operations recorded in a search trace. The cover operations are those which can be replayed on a cover
+ * built from the data alone; countDif and minusMe are not recorded since their operand is a cover saved by the search
+ */
+enum TraceOp : unsigned char {
+    TRACE_INTERSECT = 1,
+    TRACE_BACKTRACK,
+    TRACE_TEMPORARY_INTERSECT,
+    TRACE_TEMPORARY_INTERSECT_SUP,
+    TRACE_RESTRICT_ROOT,
+    TRACE_CACHE_INSERT,
+    TRACE_CACHE_FIND
+};
+
+/**
+ * SearchTrace - a recorder of the cover and cache operations of a search in a compact binary file, to replay them
+ * without the search (see traceReplay.cpp). When a trace is given to a cover (RCover::trace) or to a trie
+ * (Trie::trace), each operation appends an event; the covers and tries without trace only test a null pointer.
+ *
+ * The file starts with a header making it self-contained: "DL85TRC" and a version byte, then the numbers of
+ * transactions, attributes, classes and weights as 32-bit integers, the nWords words of each attribute cover and of
+ * each class cover as stored by the DataManager, and the weights as floats. Each event follows as its TraceOp byte and
+ * LEB128 varints:
+ *     intersect, temporary intersects: the item (attribute * 2 + positive), then the support of the intersection
+ *     backtrack: nothing
+ *     restrict root: the nWords words of the mask
+ *     cache insert, find: 1 when the itemset already had data (a hit) and 0 otherwise, its size, then the differences
+ *         between its consecutive items in zigzag encoding
+ * @param buffer - the events not written yet, flushed when it exceeds a megabyte and when the trace is closed
+ */
+class SearchTrace {
+public:
+    /**
+     * @param path - the file of the trace, created or truncated
+     * @param dm - the data of the search, written in the header
+     * @param weights - the weights of the transactions, or null
+     */
+    SearchTrace(const string &path, DataManager *dm, const vector<float> *weights = nullptr);
+
+    ~SearchTrace();
+
+    void intersect(Attribute attribute, bool positive, Support support) {
+        event(TRACE_INTERSECT);
+        putVarint(item(attribute, positive));
+        putVarint(support);
+    }
+
+    void backtrack() { event(TRACE_BACKTRACK); }
+
+    void temporaryIntersect(Attribute attribute, bool positive, Support support) {
+        event(TRACE_TEMPORARY_INTERSECT);
+        putVarint(item(attribute, positive));
+        putVarint(support);
+    }
+
+    void temporaryIntersectSup(Attribute attribute, bool positive, Support support) {
+        event(TRACE_TEMPORARY_INTERSECT_SUP);
+        putVarint(item(attribute, positive));
+        putVarint(support);
+    }
+
+    void restrictRoot(const bitset<M> *mask);
+
+    void cacheInsert(const Array<Item> &itemset, bool hit) { cacheEvent(TRACE_CACHE_INSERT, itemset, hit); }
+
+    void cacheFind(const Array<Item> &itemset, bool hit) { cacheEvent(TRACE_CACHE_FIND, itemset, hit); }
+
+    // write the buffered events and close the file
+    void close();
+
+    long long nevents = 0;
+
+private:
+    void event(TraceOp op) {
+        if (buffer.size() >= (1 << 20)) flush();
+        buffer.push_back(op);
+        ++nevents;
+    }
+
+    void putVarint(unsigned long long value) {
+        while (value >= 0x80) {
+            buffer.push_back((unsigned char) (value | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back((unsigned char) value);
+    }
+
+    void cacheEvent(TraceOp op, const Array<Item> &itemset, bool hit);
+
+    void flush();
+
+    FILE *file;
+    int nWords;
+    vector<unsigned char> buffer;
+};
+
+/**
+ * TraceEvent - an event read from a trace. The items of an itemset are stored in TraceData::items from offset and the
+ * words of a mask in TraceData::masks from offset
+ */
+struct TraceEvent {
+    TraceOp op;
+    Attribute attribute;
+    bool positive;
+    bool hit;
+    Support support;
+    int offset, size;
+};
+
+/**
+ * TraceData - the content of a trace file: the data of the search, in the layout of the search function (the data
+ * column by column), and its events
+ */
+struct TraceData {
+    int ntransactions = 0, nattributes = 0, nclasses = 0;
+    vector<int> data, target;
+    vector<float> weights;
+    vector<TraceEvent> events;
+    vector<Item> items;
+    vector<bitset<M>> masks;
+};
+
+/**
+ * readTrace - read a trace written by SearchTrace. It throws a runtime_error when the file is not a valid trace
+ */
+void readTrace(const string &path, TraceData &trace);
+
+#endif //DL85_SEARCH_TRACE_H
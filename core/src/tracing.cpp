@@ -0,0 +1,198 @@
+#include "tracing.h"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include <stdexcept>
+
+atomic<bool> Tracer::on(false);
+chrono::steady_clock::time_point Tracer::origin;
+
+namespace {
+
+// the events of a thread. Its thread is the only producer and the flusher the only consumer
+struct EventRing {
+    static const size_t CAPACITY = 1 << 16;
+    vector<TraceRecord> records = vector<TraceRecord>(CAPACITY);
+    atomic<size_t> head{0}; // the next record written by the thread
+    atomic<size_t> tail{0}; // the next record read by the flusher
+    atomic<long long> dropped{0};
+    atomic<bool> owned{false}; // whether a living thread writes in the ring
+    int tid = 0;
+};
+
+/* the state shared by the sessions. The rings are kept for the life of the process since a thread may still write an
+ event while the last session closes; the ring of a finished thread is reused by the next thread */
+struct TracingState {
+    mutex lock; // guards the fields below, except the content of the rings
+    int users = 0;
+    vector<unique_ptr<EventRing>> rings;
+    FILE *output = nullptr;
+    bool json = true;
+    bool firstRecord = true;
+    bool stopping = false;
+    condition_variable wake;
+    thread flusher;
+};
+
+TracingState &tracingState() {
+    static TracingState state;
+    return state;
+}
+
+// releases the ring of a thread when it finishes
+struct RingOwner {
+    EventRing *ring = nullptr;
+
+    ~RingOwner() { if (ring) ring->owned.store(false, memory_order_release); }
+};
+
+thread_local RingOwner ringOwner;
+
+EventRing *threadRing() {
+    if (ringOwner.ring) return ringOwner.ring;
+    TracingState &state = tracingState();
+    lock_guard<mutex> guard(state.lock);
+    for (auto &ring : state.rings) {
+        if (!ring->owned.load(memory_order_acquire)) {
+            ring->owned.store(true, memory_order_relaxed);
+            return ringOwner.ring = ring.get();
+        }
+    }
+    state.rings.emplace_back(new EventRing);
+    EventRing *ring = state.rings.back().get();
+    ring->tid = (int) state.rings.size();
+    ring->owned.store(true, memory_order_relaxed);
+    return ringOwner.ring = ring;
+}
+
+void writeEscaped(FILE *out, const char *text) {
+    for (const char *c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') fputc('\\', out);
+        fputc(*c, out);
+    }
+}
+
+void writeRecord(TracingState &state, const TraceRecord &record, int tid) {
+    FILE *out = state.output;
+    if (!state.json) {
+        fprintf(out, "[%.3f us] thread %d %s", record.ts / 1e3, tid, record.name);
+        if (record.phase == 'X') fprintf(out, " (%.3f us)", record.dur / 1e3);
+        for (int a = 0; a < record.nargs; ++a) fprintf(out, " %s=%g", record.keys[a], record.values[a]);
+        fputc('\n', out);
+        return;
+    }
+    fputs((state.firstRecord) ? "\n{\"name\":\"" : ",\n{\"name\":\"", out);
+    state.firstRecord = false;
+    writeEscaped(out, record.name);
+    fprintf(out, "\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d", record.phase, record.ts / 1e3, tid);
+    if (record.phase == 'X') fprintf(out, ",\"dur\":%.3f", record.dur / 1e3);
+    if (record.phase == 'i') fputs(",\"s\":\"t\"", out);
+    if (record.nargs) {
+        fputs(",\"args\":{", out);
+        for (int a = 0; a < record.nargs; ++a) {
+            fputs((a) ? ",\"" : "\"", out);
+            writeEscaped(out, record.keys[a]);
+            fprintf(out, "\":%.9g", record.values[a]);
+        }
+        fputc('}', out);
+    }
+    fputc('}', out);
+}
+
+// write the events of the rings. Only the flusher calls it while the session is open
+void drain(TracingState &state, const vector<EventRing *> &rings) {
+    for (EventRing *ring : rings) {
+        size_t tail = ring->tail.load(memory_order_relaxed), head = ring->head.load(memory_order_acquire);
+        for (; tail != head; ++tail) writeRecord(state, ring->records[tail & (EventRing::CAPACITY - 1)], ring->tid);
+        ring->tail.store(tail, memory_order_release);
+    }
+}
+
+vector<EventRing *> ringList(TracingState &state) {
+    vector<EventRing *> rings;
+    for (auto &ring : state.rings) rings.push_back(ring.get());
+    return rings;
+}
+
+void flushLoop() {
+    TracingState &state = tracingState();
+    unique_lock<mutex> guard(state.lock);
+    while (!state.stopping) {
+        state.wake.wait_for(guard, chrono::milliseconds(10));
+        vector<EventRing *> rings = ringList(state);
+        guard.unlock();
+        drain(state, rings);
+        guard.lock();
+    }
+}
+
+}
+
+void Tracer::push(const TraceRecord &record) {
+    EventRing *ring = threadRing();
+    size_t head = ring->head.load(memory_order_relaxed);
+    if (head - ring->tail.load(memory_order_acquire) >= EventRing::CAPACITY) {
+        ring->dropped.fetch_add(1, memory_order_relaxed);
+        return;
+    }
+    ring->records[head & (EventRing::CAPACITY - 1)] = record;
+    ring->head.store(head + 1, memory_order_release);
+}
+
+TracingSession::TracingSession(const char *path, bool console) {
+#ifdef DL85_TRACING
+    if (!path || !*path) path = getenv("DL85_TRACING_FILE");
+    if ((!path || !*path) && !console) return;
+    TracingState &state = tracingState();
+    lock_guard<mutex> guard(state.lock);
+    if (state.users == 0) {
+        bool json = path && *path;
+        FILE *output = (json) ? fopen(path, "w") : stdout;
+        if (!output) throw runtime_error("Cannot write the events to " + string(path));
+        state.output = output;
+        state.json = json;
+        state.firstRecord = true;
+        state.stopping = false;
+        // the events written since the last session are discarded
+        for (auto &ring : state.rings) {
+            ring->tail.store(ring->head.load(memory_order_acquire), memory_order_relaxed);
+            ring->dropped.store(0, memory_order_relaxed);
+        }
+        if (json) fputs("{\"traceEvents\":[", output);
+        Tracer::origin = chrono::steady_clock::now();
+        Tracer::on.store(true, memory_order_release);
+        state.flusher = thread(flushLoop);
+    }
+    ++state.users;
+    open = true;
+#endif
+}
+
+TracingSession::~TracingSession() {
+    if (!open) return;
+    TracingState &state = tracingState();
+    unique_lock<mutex> guard(state.lock);
+    if (--state.users > 0) return;
+    Tracer::on.store(false, memory_order_release);
+    state.stopping = true;
+    state.wake.notify_all();
+    guard.unlock();
+    state.flusher.join();
+    guard.lock();
+    drain(state, ringList(state));
+    long long dropped = 0;
+    for (auto &ring : state.rings) dropped += ring->dropped.load(memory_order_relaxed);
+    if (state.json) {
+        fputs("\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":\"", state.output);
+        fprintf(state.output, "%lld\"}}\n", dropped);
+        fclose(state.output);
+    } else {
+        if (dropped) fprintf(state.output, "%lld events dropped\n", dropped);
+        fflush(state.output);
+    }
+    state.output = nullptr;
+}
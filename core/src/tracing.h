@@ -0,0 +1,141 @@
+#ifndef DL85_TRACING_H
+#define DL85_TRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+using namespace std;
+
+/**
+ * The tracing of the search. The events are written with the macros below:
+ *
+ *     DL85_TRACE_SCOPE("name");                        // a duration event from here to the end of the block
+ *     DL85_TRACE_EVENT("name", "key", value, ...);     // an instant event with at most 3 numeric arguments
+ *     DL85_TRACE_COUNTER("name", value);               // a counter sample
+ *
+ * The names and the keys must be string literals. Without DL85_TRACING (a compile definition, set by CMakeLists.txt
+ * and setup.py unless the DL85_TRACING option is turned off) the macros compile to nothing and their arguments are not
+ * evaluated. With it, the events are only recorded while a TracingSession is open, and a closed session costs the load
+ * of an atomic flag per macro, the arguments still not being evaluated. So tracing can stay compiled in the production
+ * builds and be switched on per search.
+ *
+ * Each thread writes its events to its own lock-free ring buffer, drained asynchronously by a flusher thread writing
+ * them in the Chrome trace event format (read by chrome://tracing and Perfetto), or as text lines on the standard
+ * output. A thread never waits for the flusher: when its buffer is full, the event is dropped and counted
+ */
+
+#ifdef DL85_TRACING
+
+#define DL85_TRACE_CONCAT_(a, b) a##b
+#define DL85_TRACE_CONCAT(a, b) DL85_TRACE_CONCAT_(a, b)
+#define DL85_TRACE_SCOPE(name) TraceScope DL85_TRACE_CONCAT(dl85_trace_scope_, __LINE__)(name)
+#define DL85_TRACE_EVENT(...) do { if (Tracer::enabled()) Tracer::instant(__VA_ARGS__); } while (0)
+#define DL85_TRACE_COUNTER(name, value) do { if (Tracer::enabled()) Tracer::counter(name, value); } while (0)
+
+#else
+
+#define DL85_TRACE_SCOPE(name) do {} while (0)
+#define DL85_TRACE_EVENT(...) do {} while (0)
+#define DL85_TRACE_COUNTER(name, value) do {} while (0)
+
+#endif
+
+#define DL85_TRACE_MAX_ARGS 3
+
+/**
+ * TraceRecord - an event in a ring buffer
+ * @param phase - the phase of the event in the Chrome format: 'X' for a duration, 'i' for an instant, 'C' for a counter
+ * @param ts - the start of the event in ns since the opening of the session
+ * @param dur - the duration of the event in ns
+ */
+struct TraceRecord {
+    const char *name;
+    const char *keys[DL85_TRACE_MAX_ARGS];
+    double values[DL85_TRACE_MAX_ARGS];
+    long long ts, dur;
+    char phase;
+    unsigned char nargs;
+};
+
+class Tracer {
+public:
+    static bool enabled() { return on.load(memory_order_relaxed); }
+
+    // the time in ns since the opening of the session
+    static long long now() {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - origin).count();
+    }
+
+    template<typename... Args>
+    static void instant(const char *name, Args... args) {
+        TraceRecord record{name, {}, {}, now(), 0, 'i', 0};
+        setArgs(record, args...);
+        push(record);
+    }
+
+    static void counter(const char *name, double value) {
+        push(TraceRecord{name, {"value"}, {value}, now(), 0, 'C', 1});
+    }
+
+    // write an event in the buffer of the calling thread, or drop it when the buffer is full
+    static void push(const TraceRecord &record);
+
+private:
+    static void setArgs(TraceRecord &record) {}
+
+    template<typename V, typename... Rest>
+    static void setArgs(TraceRecord &record, const char *key, V value, Rest... rest) {
+        if (record.nargs < DL85_TRACE_MAX_ARGS) {
+            record.keys[record.nargs] = key;
+            record.values[record.nargs++] = (double) value;
+        }
+        setArgs(record, rest...);
+    }
+
+    static atomic<bool> on;
+    static chrono::steady_clock::time_point origin;
+
+    friend class TracingSession;
+};
+
+// a duration event covering the lifetime of the object. The event is recorded if the session is open at its creation
+class TraceScope {
+public:
+    explicit TraceScope(const char *name) : name(name), start(Tracer::enabled() ? Tracer::now() : -1) {}
+
+    ~TraceScope() {
+        if (start >= 0 && Tracer::enabled())
+            Tracer::push(TraceRecord{name, {}, {}, start, Tracer::now() - start, 'X', 0});
+    }
+
+private:
+    const char *name;
+    long long start;
+};
+
+/**
+ * TracingSession - the recording of the events while the object lives. The sessions are shared: when a session is
+ * already open, for instance by a search running in another thread, a new one joins it and its events go to the same
+ * output. The output is written when the last session is closed
+ */
+class TracingSession {
+public:
+    /**
+     * @param path - the file of the events in the Chrome trace event format. When it is null, the environment
+     * variable DL85_TRACING_FILE gives the file, so that the tracing of a job can be switched on without changing
+     * its code
+     * @param console - whether the events are written as text on the standard output when there is no file
+     */
+    explicit TracingSession(const char *path, bool console = false);
+
+    ~TracingSession();
+
+    // whether the session records the events. It is false when nothing is requested or without DL85_TRACING
+    bool isOpen() const { return open; }
+
+private:
+    bool open = false;
+};
+
+#endif //DL85_TRACING_H
@@ -0,0 +1,129 @@
+#include "treePredictor.h"
+#include "rCoverStats.h"
+#include <stdexcept>
+
+TreePredictor::TreePredictor(const int *feature, const int *left, const int *right, int nnodes, const int *roots,
+                             int ntrees) :
+        feature(feature, feature + nnodes), left(left, left + nnodes), right(right, right + nnodes) {
+    if (nnodes < 1 || ntrees < 1) throw invalid_argument("The tree has no node");
+    if (roots) this->roots.assign(roots, roots + ntrees);
+    else this->roots.assign(1, 0);
+    for (int root : this->roots)
+        if (root < 0 || root >= nnodes) throw invalid_argument("The root " + to_string(root) + " is not a node");
+
+    vector<int> node_depth(nnodes, 0);
+    for (int node = 0; node < nnodes; ++node) {
+        if (feature[node] < 0) continue;
+        for (int child : {left[node], right[node]}) {
+            if (child <= node || child >= nnodes) throw invalid_argument("The tree arrays are not in preorder");
+            node_depth[child] = node_depth[node] + 1;
+            depth = max(depth, node_depth[child]);
+        }
+        if (feature[node] >= (int) column.size()) column.resize(feature[node] + 1, -1);
+        if (column[feature[node]] < 0) {
+            column[feature[node]] = (int) used_features.size();
+            used_features.push_back(feature[node]);
+        }
+    }
+}
+
+// visit(tree, leaf, tid) is called for the leaf of each tree reached by each transaction of the blocks of a thread
+template<class LeafVisitor>
+void TreePredictor::predictBlocks(const int *data, int ntransactions, int nfeatures, bool use_threads,
+                                  LeafVisitor visit) const {
+    if ((int) column.size() > nfeatures)
+        throw invalid_argument("The tree tests the feature " + to_string(column.size() - 1) + " but the data only have "
+                               + to_string(nfeatures) + " features");
+    int block_size = PREDICTION_BLOCK_WORDS * M;
+    int nblocks = (ntransactions + block_size - 1) / block_size;
+    parallel_for(nblocks, [&](int start, int end) {
+        vector<bitset<M>> packed(used_features.size() * PREDICTION_BLOCK_WORDS);
+        vector<const bitset<M> *> columns(used_features.size());
+        // one cover per depth: the covers of the nodes on the path from the root to the current node
+        vector<bitset<M>> covers((depth + 1) * PREDICTION_BLOCK_WORDS);
+        for (int b = start; b < end; ++b) {
+            int first = b * block_size, size = min(ntransactions, first + block_size) - first;
+            int nWords = (size + M - 1) / M;
+            fill(packed.begin(), packed.end(), bitset<M>());
+            for (int i = 0; i < (int) used_features.size(); ++i) {
+                DataManager::packColumn(data + (long) ntransactions * used_features[i] + first, size, 1,
+                                        &packed[i * nWords]);
+                columns[i] = &packed[i * nWords];
+            }
+            for (int t = 0; t < (int) roots.size(); ++t) {
+                for (int w = 0; w < nWords; ++w) covers[w].set();
+                if (size % M) covers[0] = bitset<M>((1ULL << (size % M)) - 1); // word of the last transactions
+                auto tree_visit = [&](int leaf, int tid) { visit(t, leaf, tid); };
+                route(roots[t], 0, first, nWords, columns.data(), covers.data(), tree_visit);
+            }
+        }
+    }, use_threads && nblocks > 1);
+}
+
+// split the cover of a node at the depth d between its children, down to the leaves
+template<class LeafVisitor>
+void TreePredictor::route(int node, int d, int first, int nWords, const bitset<M> *const *columns,
+                          bitset<M> *covers, LeafVisitor &visit) const {
+    const bitset<M> *cover = covers + d * nWords;
+    if (feature[node] < 0) {
+        for (int w = 0; w < nWords; ++w) {
+            int first_tid = first + (nWords - (w + 1)) * M;
+            for (unsigned long long bits = cover[w].to_ullong(); bits; bits &= bits - 1)
+                visit(node, first_tid + lowestSetBit(bits));
+        }
+        return;
+    }
+    const bitset<M> *attr = columns[column[feature[node]]];
+    bitset<M> *child = covers + (d + 1) * nWords;
+    for (bool positive : {true, false}) {
+        bool empty = true;
+        for (int w = 0; w < nWords; ++w) {
+            child[w] = (positive) ? cover[w] & attr[w] : cover[w] & ~attr[w];
+            if (child[w].any()) empty = false;
+        }
+        if (!empty) route((positive) ? left[node] : right[node], d + 1, first, nWords, columns, covers, visit);
+    }
+}
+
+void TreePredictor::predictLeaves(const int *data, int ntransactions, int nfeatures, int *leaves,
+                                  bool use_threads) const {
+    int ntrees = (int) roots.size();
+    predictBlocks(data, ntransactions, nfeatures, use_threads,
+                  [=](int tree, int leaf, int tid) { leaves[(long) tid * ntrees + tree] = leaf; });
+}
+
+void TreePredictor::predictLeaves(DataManager *dm, int *leaves) const {
+    if ((int) column.size() > dm->getNAttributes())
+        throw invalid_argument("The tree tests the feature " + to_string(column.size() - 1) + " but the data only have "
+                               + to_string(dm->getNAttributes()) + " features");
+    int ntransactions = dm->getNTransactions(), nWords = dm->nWords;
+    if (ntransactions == 0) return;
+    vector<const bitset<M> *> columns(used_features.size());
+    for (int i = 0; i < (int) used_features.size(); ++i) columns[i] = dm->getAttributeCover(used_features[i]);
+    vector<bitset<M>> covers((depth + 1) * nWords);
+    for (int w = 0; w < nWords; ++w) covers[w].set();
+    if (ntransactions % M) covers[0] = bitset<M>((1ULL << (ntransactions % M)) - 1);
+    auto visit = [=](int leaf, int tid) { leaves[tid] = leaf; };
+    route(roots[0], 0, 0, nWords, columns.data(), covers.data(), visit);
+}
+
+void TreePredictor::predictValues(const int *data, int ntransactions, int nfeatures, const float *values, int nvalues,
+                                  float *predictions, bool use_threads) const {
+    predictBlocks(data, ntransactions, nfeatures, use_threads, [=](int tree, int leaf, int tid) {
+        if (tree == 0) copy(values + (long) leaf * nvalues, values + (long) (leaf + 1) * nvalues,
+                            predictions + (long) tid * nvalues);
+    });
+}
+
+// the votes of a transaction are only written by the thread of its block, so they need no synchronization
+void TreePredictor::predictVotes(const int *data, int ntransactions, int nfeatures, const int *leaf_class,
+                                 const float *tree_weights, int nclasses, double *votes, bool use_threads) const {
+    for (int node = 0; node < (int) feature.size(); ++node)
+        if (feature[node] < 0 && (leaf_class[node] < 0 || leaf_class[node] >= nclasses))
+            throw invalid_argument("The leaf " + to_string(node) + " predicts the unknown class " +
+                                   to_string(leaf_class[node]));
+    fill(votes, votes + (long) ntransactions * nclasses, 0.);
+    predictBlocks(data, ntransactions, nfeatures, use_threads, [=](int tree, int leaf, int tid) {
+        votes[(long) tid * nclasses + leaf_class[leaf]] += tree_weights[tree];
+    });
+}
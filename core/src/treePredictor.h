@@ -0,0 +1,75 @@
+#ifndef TREE_PREDICTOR_H
+#define TREE_PREDICTOR_H
+
+#include "dataManager.h"
+#include <vector>
+
+using namespace std;
+
+// number of words of M transactions packed at once by a thread (4096 transactions)
+#define PREDICTION_BLOCK_WORDS 64
+
+/**
+ * TreePredictor - route transactions to the leaves of trees given by the flat preorder arrays of Tree. The binary
+ * features used by the trees are packed block by block into bitsets as in DataManager, then the cover of each node is
+ * computed with one AND per word, from the root to the leaves. The blocks of transactions are shared between threads.
+ * The trees of an ensemble are stored one after the other in the same arrays: a block is packed once for all of them
+ * @param feature - the feature tested by each node, -1 for the leaves
+ * @param left - the child of each node for the transactions having the feature (value 1), -1 for the leaves
+ * @param right - the child of each node for the transactions not having the feature (value 0), -1 for the leaves
+ * @param roots - the root of each tree. Null for a single tree whose root is the node 0
+ */
+class TreePredictor {
+public:
+    TreePredictor(const int *feature, const int *left, const int *right, int nnodes, const int *roots = nullptr,
+                  int ntrees = 1);
+
+    /**
+     * predictLeaves - find the leaf reached by each transaction in each tree
+     * @param data - the binary features, column by column: the nfeatures columns of ntransactions values are stored
+     * one after the other as for the search
+     * @param leaves - receives the index of the leaf of each tree, transaction by transaction
+     * @param use_threads - whether the blocks of transactions are shared between threads
+     */
+    void predictLeaves(const int *data, int ntransactions, int nfeatures, int *leaves, bool use_threads = true) const;
+
+    /**
+     * predictValues - find the value(s) of the leaf reached by each transaction in the first tree
+     * @param values - the nvalues values of each node (see Tree)
+     * @param predictions - receives the nvalues values of each transaction, transaction by transaction
+     */
+    void predictValues(const int *data, int ntransactions, int nfeatures, const float *values, int nvalues,
+                       float *predictions, bool use_threads = true) const;
+
+    /**
+     * predictVotes - sum the weighted votes of the trees of an ensemble for the classes of each transaction
+     * @param leaf_class - the class (between 0 and nclasses - 1) predicted by each leaf
+     * @param tree_weights - the weight of the vote of each tree
+     * @param votes - receives the nclasses sums of each transaction, transaction by transaction
+     */
+    void predictVotes(const int *data, int ntransactions, int nfeatures, const int *leaf_class,
+                      const float *tree_weights, int nclasses, double *votes, bool use_threads = true) const;
+
+    /**
+     * predictLeaves - find the leaf reached by each transaction of a data manager in the first tree. The covers of
+     * the attributes are already packed, so the transactions are routed in one pass over them without packing
+     */
+    void predictLeaves(DataManager *dm, int *leaves) const;
+
+    int getNTrees() const { return (int) roots.size(); }
+
+private:
+    vector<int> feature, left, right, roots;
+    vector<int> used_features; // the distinct features tested by the trees
+    vector<int> column; // the index of each feature in used_features, -1 for the features not tested
+    int depth = 0; // the number of edges of the longest branch
+
+    template<class LeafVisitor>
+    void predictBlocks(const int *data, int ntransactions, int nfeatures, bool use_threads, LeafVisitor visit) const;
+
+    template<class LeafVisitor>
+    void route(int node, int d, int first, int nWords, const bitset<M> *const *columns, bitset<M> *covers,
+               LeafVisitor &visit) const;
+};
+
+#endif
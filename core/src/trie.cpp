@@ -51,10 +51,12 @@ TrieNode *Trie::find(
         e = p->edges.end();
         t = lower_bound(p->edges.begin(), e, itemset[i], lessTrieEdge);
         if (t == e || t->item != itemset[i]) {
+            if (trace) trace->cacheFind(itemset, false);
             return nullptr; // not found
         } else
             p = t->subtrie;
     }
+    if (trace) trace->cacheFind(itemset, p->data != nullptr);
     return p;
 }
 
@@ -75,10 +77,12 @@ TrieNode *Trie::insert(
                                          p2);/// create path representing the part of the itemset not yet present in the trie. So you have to provide the position at which the part not present starts and the last node at which we must complete the tree
             p->edges.insert(t, newedge);
 
+            if (trace) trace->cacheInsert(itemset, false);
             return p2;
         } else {
             p = t->subtrie;
         }
     }
+    if (trace) trace->cacheInsert(itemset, p->data != nullptr);
     return p;
 }
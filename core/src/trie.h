@@ -3,6 +3,7 @@
 #include <vector> // we only use arrays for +- fixed sized things
 #include "globals.h"
 #include "query.h"
+#include "searchTrace.h"
 
 using namespace std;
 
@@ -29,6 +30,7 @@ public:
     TrieNode *insert ( Array<Item> itemset );
     TrieNode *find ( Array<Item> itemset );
     TrieNode *root;
+    SearchTrace *trace = nullptr; // the recorder of the inserts and finds, or null (see SearchTrace)
     TrieNode *createTree ( Array<Item> itemset, int pos, TrieNode *&last );
 };
 
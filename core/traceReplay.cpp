@@ -0,0 +1,284 @@
+//
+// Replay of a search trace (see SearchTrace): re-executes the cover operations or the cache operations recorded
+// during a search on alternative engines, without the search logic, and reports their time per operation. The results
+// of the replayed operations are checked against those of the search.
+//
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <unordered_set>
+#include <memory>
+#include <stdexcept>
+#include "benchmarkDataset.h"
+#include "dataManager.h"
+#include "rCoverTotalFreq.h"
+#include "rCoverWeighted.h"
+#include "searchTrace.h"
+#include "trie.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// a cover implementation replaying the cover operations
+class CoverEngine {
+public:
+    virtual ~CoverEngine() {}
+
+    virtual Support intersect(Attribute attribute, bool positive) = 0;
+
+    virtual void backtrack() = 0;
+
+    virtual Support temporaryIntersect(Attribute attribute, bool positive) = 0;
+
+    virtual Support temporaryIntersectSup(Attribute attribute, bool positive) = 0;
+
+    virtual void restrictRoot(const bitset<M> *mask) = 0;
+};
+
+// the engine of the covers of the search
+class RCoverEngine : public CoverEngine {
+public:
+    explicit RCoverEngine(RCover *cover) : cover(cover) {}
+
+    Support intersect(Attribute attribute, bool positive) {
+        cover->intersect(attribute, positive);
+        return cover->getSupport();
+    }
+
+    void backtrack() { cover->backtrack(); }
+
+    Support temporaryIntersect(Attribute attribute, bool positive) {
+        pair<Supports, Support> result = cover->temporaryIntersect(attribute, positive);
+        deleteSupports(result.first);
+        return result.second;
+    }
+
+    Support temporaryIntersectSup(Attribute attribute, bool positive) {
+        return cover->temporaryIntersectSup(attribute, positive);
+    }
+
+    void restrictRoot(const bitset<M> *mask) { cover->restrictRoot(mask); }
+
+private:
+    unique_ptr<RCover> cover;
+};
+
+// a cache implementation replaying the inserts and finds of itemsets. Both return whether the itemset had been inserted
+class CacheEngine {
+public:
+    virtual ~CacheEngine() {}
+
+    virtual bool insert(Array<Item> itemset) = 0;
+
+    virtual bool find(Array<Item> itemset) = 0;
+};
+
+// the trie of the search. As in the search, an itemset is in the cache once its node has data
+class TrieEngine : public CacheEngine {
+public:
+    bool insert(Array<Item> itemset) {
+        TrieNode *node = trie.insert(itemset);
+        if (node->data) return true;
+        node->data = new QueryData(nullptr);
+        return false;
+    }
+
+    bool find(Array<Item> itemset) {
+        TrieNode *node = trie.find(itemset);
+        return node && node->data;
+    }
+
+private:
+    Trie trie;
+};
+
+// a hash table of the itemsets
+class HashEngine : public CacheEngine {
+public:
+    bool insert(Array<Item> itemset) { return !itemsets.insert(key(itemset)).second; }
+
+    bool find(Array<Item> itemset) { return itemsets.count(key(itemset)) > 0; }
+
+private:
+    static string key(Array<Item> itemset) {
+        return string((const char *) itemset.elts, itemset.size * sizeof(Item));
+    }
+
+    unordered_set<string> itemsets;
+};
+
+// the time and the count of the replayed operations of each kind, and the number of results differing from the search.
+// The total is the time of the replay without the clocks of the operations
+struct Replay {
+    double total = 0;
+    double time[TRACE_CACHE_FIND + 1] = {0};
+    long long count[TRACE_CACHE_FIND + 1] = {0};
+    long long mismatches = 0;
+};
+
+static const char *opName(int op) {
+    switch (op) {
+        case TRACE_INTERSECT: return "intersect";
+        case TRACE_BACKTRACK: return "backtrack";
+        case TRACE_TEMPORARY_INTERSECT: return "temporaryIntersect";
+        case TRACE_TEMPORARY_INTERSECT_SUP: return "temporaryIntersectSup";
+        case TRACE_RESTRICT_ROOT: return "restrictRoot";
+        case TRACE_CACHE_INSERT: return "cacheInsert";
+        default: return "cacheFind";
+    }
+}
+
+// replay the cover events in order. When timeEvents is false only the total time is measured, otherwise each event is
+// timed alone, which adds the cost of the clock to each of them
+static Replay replayCover(const TraceData &trace, const vector<TraceEvent> &events, CoverEngine &engine,
+                          bool timeEvents) {
+    Replay replay;
+    auto begin = steady_clock::now();
+    for (const TraceEvent &event : events) {
+        Support support = event.support;
+        steady_clock::time_point start;
+        if (timeEvents) start = steady_clock::now();
+        switch (event.op) {
+            case TRACE_INTERSECT: support = engine.intersect(event.attribute, event.positive); break;
+            case TRACE_BACKTRACK: engine.backtrack(); break;
+            case TRACE_TEMPORARY_INTERSECT: support = engine.temporaryIntersect(event.attribute, event.positive); break;
+            case TRACE_TEMPORARY_INTERSECT_SUP:
+                support = engine.temporaryIntersectSup(event.attribute, event.positive);
+                break;
+            default: engine.restrictRoot(trace.masks.data() + event.offset);
+        }
+        if (timeEvents) replay.time[event.op] += duration<double>(steady_clock::now() - start).count();
+        ++replay.count[event.op];
+        if (support != event.support) ++replay.mismatches;
+    }
+    replay.total = duration<double>(steady_clock::now() - begin).count();
+    return replay;
+}
+
+static Replay replayCache(const TraceData &trace, const vector<TraceEvent> &events, CacheEngine &engine,
+                          bool timeEvents) {
+    Replay replay;
+    vector<Item> items = trace.items; // the engines get non-const itemsets, as in the search
+    auto begin = steady_clock::now();
+    for (const TraceEvent &event : events) {
+        Array<Item> itemset(items.data() + event.offset, event.size);
+        steady_clock::time_point start;
+        if (timeEvents) start = steady_clock::now();
+        bool hit = (event.op == TRACE_CACHE_INSERT) ? engine.insert(itemset) : engine.find(itemset);
+        if (timeEvents) replay.time[event.op] += duration<double>(steady_clock::now() - start).count();
+        ++replay.count[event.op];
+        if (hit != event.hit) ++replay.mismatches;
+    }
+    replay.total = duration<double>(steady_clock::now() - begin).count();
+    return replay;
+}
+
+// the runs alternate a replay timed as a whole and a replay timed event by event. The fastest of each is reported
+static void report(const string &engine, const vector<Replay> &runs, int firstOp, int lastOp) {
+    long long count = 0;
+    double total = runs[0].total;
+    for (size_t r = 0; r < runs.size(); r += 2) total = min(total, runs[r].total);
+    for (int op = firstOp; op <= lastOp; ++op) {
+        count += runs[0].count[op];
+        if (runs[0].count[op] == 0) continue;
+        double best = runs[1].time[op];
+        for (size_t r = 1; r < runs.size(); r += 2) best = min(best, runs[r].time[op]);
+        cout << engine << "," << opName(op) << "," << runs[0].count[op] << "," << best << ","
+             << best * 1e9 / runs[0].count[op] << "," << runs[0].mismatches << "\n";
+    }
+    cout << engine << ",all," << count << "," << total << "," << total * 1e9 / max(1LL, count) << ","
+         << runs[0].mismatches << "\n";
+}
+
+static void usage() {
+    cerr << "usage: dl85_trace_replay TRACE [options]\n"
+            "  --covers E,E         cover engines: totalfreq, weighted (default totalfreq, and weighted when the\n"
+            "                       trace has weights)\n"
+            "  --caches E,E         cache engines: trie, hash (default trie,hash)\n"
+            "  --repeat N           replays per engine, the fastest is kept (default 3)\n"
+            "The trace is recorded by the search when a trace file is given (trace_file of solve in python).\n"
+            "The output is a CSV line per engine and operation: the count, the total time in seconds, the time per\n"
+            "operation in ns and the number of results of the engine which differ from those of the search. The\n"
+            "times of the operations include the cost of a clock, the line \"all\" is the replay timed as a whole." << endl;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || string(argv[1]) == "--help" || string(argv[1]) == "-h") {
+        usage();
+        return argc < 2 ? 2 : 0;
+    }
+    string path = argv[1];
+    vector<string> covers, caches = {"trie", "hash"};
+    int repeat = 3;
+    for (int a = 2; a < argc; ++a) {
+        string option = argv[a];
+        if (a + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        string value = argv[++a];
+        if (option == "--covers") covers = split(value);
+        else if (option == "--caches") caches = split(value);
+        else if (option == "--repeat") repeat = max(1, stoi(value));
+        else {
+            usage();
+            return 2;
+        }
+    }
+
+    TraceData trace;
+    try {
+        readTrace(path, trace);
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 2;
+    }
+    if (covers.empty()) covers = (trace.weights.empty()) ? vector<string>{"totalfreq"} :
+                                 vector<string>{"totalfreq", "weighted"};
+    // the cover and the cache events are replayed separately
+    vector<TraceEvent> coverEvents, cacheEvents;
+    for (const TraceEvent &event : trace.events)
+        ((event.op < TRACE_CACHE_INSERT) ? coverEvents : cacheEvents).push_back(event);
+    cerr << path << ": " << trace.events.size() << " events on " << trace.ntransactions << " transactions and "
+         << trace.nattributes << " attributes" << endl;
+
+    // the data manager needs two classes at least, as in the search
+    vector<SupportClass> supports(max(trace.nclasses, 2), 0);
+    for (int c : trace.target) ++supports[c];
+    DataManager dm(supports.data(), trace.ntransactions, trace.nattributes, (int) supports.size(), trace.data.data(),
+                   trace.target.data());
+    vector<float> weights = trace.weights;
+    if (weights.empty()) weights.assign(trace.ntransactions, 1);
+
+    cout << "engine,operation,count,time,ns_per_op,mismatches\n";
+    for (const string &name : covers) {
+        vector<Replay> runs;
+        for (int r = 0; r < 2 * repeat; ++r) {
+            RCover *cover;
+            if (name == "totalfreq") cover = new RCoverTotalFreq(&dm);
+            else if (name == "weighted") cover = new RCoverWeighted(&dm, &weights);
+            else {
+                cerr << "unknown cover engine " << name << endl;
+                return 2;
+            }
+            RCoverEngine engine(cover);
+            runs.push_back(replayCover(trace, coverEvents, engine, r % 2 == 1));
+        }
+        report(name, runs, TRACE_INTERSECT, TRACE_RESTRICT_ROOT);
+    }
+    for (const string &name : caches) {
+        vector<Replay> runs;
+        for (int r = 0; r < 2 * repeat; ++r) {
+            unique_ptr<CacheEngine> engine;
+            if (name == "trie") engine.reset(new TrieEngine);
+            else if (name == "hash") engine.reset(new HashEngine);
+            else {
+                cerr << "unknown cache engine " << name << endl;
+                return 2;
+            }
+            runs.push_back(replayCache(trace, cacheEvents, *engine, r % 2 == 1));
+        }
+        report(name, runs, TRACE_CACHE_INSERT, TRACE_CACHE_FIND);
+    }
+    return 0;
+}
@@ -30,12 +30,431 @@ cdef extern from "py_support_error_class_function_wrapper.h":
         PySupportErrorClassWrapper(object) # define a constructor that takes a Python object
              # note - doesn't match c++ signature - that's fine!
 
+cdef extern from "py_batch_error_class_function_wrapper.h":
+    cdef cppclass PyBatchErrorClassWrapper:
+        PyBatchErrorClassWrapper()
+        PyBatchErrorClassWrapper(object) # define a constructor that takes a Python object
+             # note - doesn't match c++ signature - that's fine!
+
+cdef extern from "../core/src/nativeError.h":
+    cdef cppclass NativeError:
+        pass
+    cdef cppclass PluginError(NativeError):
+        PluginError(string) except +
+
 cdef extern from "py_tid_error_function_wrapper.h":
     cdef cppclass PyTidErrorWrapper:
         PyTidErrorWrapper()
         PyTidErrorWrapper(object) # define a constructor that takes a Python object
              # note - doesn't match c++ signature - that's fine!
 
+cdef extern from "../core/src/searchStats.h":
+    cdef cppclass SearchStats:
+        double successorTime
+        double intersectTime
+        double depthTwoCountTime
+        double depthTwoSelectTime
+        double cacheTime
+        double boundTime
+        double callbackTime
+        long long depthTwoCalls
+        long long cacheHits
+        long long prunedInfeasible
+        long long prunedLowest
+        long long prunedCanSkip
+        long long prunedMinsup
+
+cdef extern from "../core/src/query.h":
+    cdef cppclass Tree:
+        vector[int] feature
+        vector[int] left
+        vector[int] right
+        vector[float] value
+        vector[float] error
+        int nvalues
+        vector[int] transactionLeaf
+        vector[int] nodeSamples
+        vector[float] nodeWeight
+        vector[float] nodeDistribution
+        int ndistribution
+        SearchStats stats
+
+
+cdef class FlatTree:
+    # owner of the arrays of a tree returned by the search. The numpy arrays given by arrays() are views on its
+    # memory and keep it alive
+    cdef Tree tree
+
+    def arrays(self):
+        cdef int nnodes = self.tree.feature.size()
+        return {"feature": _flat_tree_array(self, self.tree.feature.data(), nnodes, 1, sizeof(int), b"i"),
+                "left": _flat_tree_array(self, self.tree.left.data(), nnodes, 1, sizeof(int), b"i"),
+                "right": _flat_tree_array(self, self.tree.right.data(), nnodes, 1, sizeof(int), b"i"),
+                "value": _flat_tree_array(self, self.tree.value.data(), nnodes, self.tree.nvalues, sizeof(float), b"f"),
+                "error": _flat_tree_array(self, self.tree.error.data(), nnodes, 1, sizeof(float), b"f"),
+                "transaction_leaf": _flat_tree_array(self, self.tree.transactionLeaf.data(), self.tree.transactionLeaf.size(),
+                                                     1, sizeof(int), b"i") if self.tree.transactionLeaf.size() > 0
+                                    else np.zeros(0, dtype=np.int32),
+                "n_node_samples": _flat_tree_array(self, self.tree.nodeSamples.data(), self.tree.nodeSamples.size(), 1,
+                                                   sizeof(int), b"i") if self.tree.nodeSamples.size() > 0
+                                  else np.zeros(0, dtype=np.int32),
+                "weighted_n_node_samples": _flat_tree_array(self, self.tree.nodeWeight.data(), self.tree.nodeWeight.size(),
+                                                            1, sizeof(float), b"f") if self.tree.nodeWeight.size() > 0
+                                           else np.zeros(0, dtype=np.float32),
+                "distribution": _flat_tree_array(self, self.tree.nodeDistribution.data(), self.tree.nodeSamples.size(),
+                                                 self.tree.ndistribution, sizeof(float), b"f")
+                                if self.tree.nodeDistribution.size() > 0
+                                else np.zeros((self.tree.nodeSamples.size(), self.tree.ndistribution), dtype=np.float32),
+                "stats": self.stats()}
+
+    def stats(self):
+        # the statistics of the search (see SearchStats): the times in seconds and the counts of pruned nodes
+        cdef SearchStats *stats = &self.tree.stats
+        return {"successor_time": stats.successorTime,
+                "intersect_time": stats.intersectTime,
+                "depth_two_count_time": stats.depthTwoCountTime,
+                "depth_two_select_time": stats.depthTwoSelectTime,
+                "cache_time": stats.cacheTime,
+                "bound_time": stats.boundTime,
+                "callback_time": stats.callbackTime,
+                "depth_two_calls": stats.depthTwoCalls,
+                "cache_hits": stats.cacheHits,
+                "pruned_infeasible": stats.prunedInfeasible,
+                "pruned_lowest": stats.prunedLowest,
+                "pruned_can_skip": stats.prunedCanSkip,
+                "pruned_minsup": stats.prunedMinsup}
+
+
+cdef class FlatTreeArray:
+    # buffer exported to numpy for one array of a FlatTree, so that the array is not copied
+    cdef FlatTree owner
+    cdef void *data
+    cdef int ndim
+    cdef Py_ssize_t itemsize
+    cdef Py_ssize_t shape[2]
+    cdef Py_ssize_t strides[2]
+    cdef bytes format
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        buffer.buf = self.data
+        buffer.obj = self
+        buffer.len = self.shape[0] * self.shape[1] * self.itemsize
+        buffer.readonly = 0
+        buffer.itemsize = self.itemsize
+        buffer.format = self.format
+        buffer.ndim = self.ndim
+        buffer.shape = self.shape
+        buffer.strides = self.strides
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+
+    def __releasebuffer__(self, Py_buffer *buffer):
+        pass
+
+
+cdef object _flat_tree_array(FlatTree owner, void *data, Py_ssize_t nrows, Py_ssize_t ncols, Py_ssize_t itemsize, bytes format):
+    cdef FlatTreeArray view = FlatTreeArray()
+    view.owner = owner
+    view.data = data
+    view.ndim = 1 if ncols == 1 else 2
+    view.itemsize = itemsize
+    view.shape[0] = nrows
+    view.shape[1] = ncols
+    view.strides[0] = ncols * itemsize
+    view.strides[1] = itemsize
+    view.format = format
+    return np.asarray(view)
+
+
+cdef extern from "../core/src/treePredictor.h":
+    cdef cppclass TreePredictor:
+        TreePredictor(const int *feature, const int *left, const int *right, int nnodes, const int *roots, int ntrees) except +
+        void predictLeaves(const int *data, int ntransactions, int nfeatures, int *leaves, bool use_threads) nogil except +
+        void predictVotes(const int *data, int ntransactions, int nfeatures, const int *leaf_class,
+                          const float *tree_weights, int nclasses, double *votes, bool use_threads) nogil except +
+
+
+cdef TreePredictor *_new_tree_predictor(feature, left, right, roots) except NULL:
+    # the trees are copied by the predictor
+    feature = np.ascontiguousarray(feature, dtype=np.int32)
+    left = np.ascontiguousarray(left, dtype=np.int32)
+    right = np.ascontiguousarray(right, dtype=np.int32)
+    roots = np.ascontiguousarray(roots, dtype=np.int32)
+    if not (feature.shape == left.shape == right.shape) or feature.ndim != 1 or roots.ndim != 1:
+        raise ValueError("The tree arrays must be 1D arrays of the same length")
+    if len(feature) == 0 or len(roots) == 0:
+        raise ValueError("The tree has no node")
+    cdef int [::1] feature_view = feature
+    cdef int [::1] left_view = left
+    cdef int [::1] right_view = right
+    cdef int [::1] roots_view = roots
+    return new TreePredictor(&feature_view[0], &left_view[0], &right_view[0], len(feature), &roots_view[0], len(roots))
+
+
+def _predictor_data(data):
+    # the columns are stored one after the other as for the search. Empty data keep one dummy value to be addressed
+    data = np.ascontiguousarray(np.asarray(data).T, dtype=np.int32)
+    if data.ndim != 2:
+        raise ValueError("The data must be a 2D array")
+    return data if data.size > 0 else np.zeros((max(data.shape[0], 1), 1), dtype=np.int32)
+
+
+def predict_leaves(data, feature, left, right, use_threads=True):
+    """Returns the preorder index of the leaf reached by each row of the binary data in the tree given by the flat
+    arrays feature, left (child of the rows having the feature) and right. The rows are routed by blocks of bit-packed
+    columns, in parallel when use_threads is set"""
+    cdef int ntransactions = np.shape(data)[0]
+    cdef int nfeatures = np.shape(data)[1]
+    cdef int [:, ::1] data_view = _predictor_data(data)
+    leaves = np.zeros(max(ntransactions, 1), dtype=np.int32)
+    cdef int [::1] leaves_view = leaves
+    cdef bool threads = use_threads
+    cdef TreePredictor *predictor = _new_tree_predictor(feature, left, right, [0])
+    try:
+        with nogil:
+            predictor.predictLeaves(&data_view[0][0], ntransactions, nfeatures, &leaves_view[0], threads)
+    finally:
+        del predictor
+    return leaves[:ntransactions]
+
+
+def predict_votes(data, feature, left, right, roots, leaf_class, tree_weights, n_classes, use_threads=True):
+    """Returns the sums of the weighted votes of the trees of an ensemble for each class (columns) and each row of the
+    binary data (rows). The trees are stored one after the other in the flat arrays, with global node indexes, and
+    start at the nodes roots. A leaf votes for the class leaf_class (between 0 and n_classes - 1) with the weight of its
+    tree. All the trees are evaluated on the same bit-packed blocks of columns"""
+    cdef int ntransactions = np.shape(data)[0]
+    cdef int nfeatures = np.shape(data)[1]
+    cdef int [:, ::1] data_view = _predictor_data(data)
+    leaf_class = np.ascontiguousarray(leaf_class, dtype=np.int32)
+    tree_weights = np.ascontiguousarray(tree_weights, dtype=np.float32)
+    if leaf_class.shape != np.shape(feature) or tree_weights.shape != np.shape(roots):
+        raise ValueError("leaf_class must have one entry per node and tree_weights one per tree")
+    if n_classes < 1:
+        raise ValueError("The ensemble has no class")
+    cdef int [::1] leaf_class_view = leaf_class
+    cdef float [::1] tree_weights_view = tree_weights
+    cdef int nclasses = n_classes
+    votes = np.zeros((max(ntransactions, 1), nclasses), dtype=np.float64)
+    cdef double [:, ::1] votes_view = votes
+    cdef bool threads = use_threads
+    cdef TreePredictor *predictor = _new_tree_predictor(feature, left, right, roots)
+    try:
+        with nogil:
+            predictor.predictVotes(&data_view[0][0], ntransactions, nfeatures, &leaf_class_view[0],
+                                   &tree_weights_view[0], nclasses, &votes_view[0][0], threads)
+    finally:
+        del predictor
+    return votes[:ntransactions]
+
+
+cdef extern from "../core/src/completeTree.h":
+    cdef cppclass CompleteTree:
+        CompleteTree(const int *feature, const int *left, const int *right, const float *value, int nnodes, int nvalues) except +
+        string toCppHeader(string name, bool conditional) except +
+        int depth
+        vector[int] feature
+        vector[float] value
+
+
+cdef CompleteTree *_new_complete_tree(feature, left, right, value) except NULL:
+    # the tree is copied by the complete tree
+    feature = np.ascontiguousarray(feature, dtype=np.int32)
+    left = np.ascontiguousarray(left, dtype=np.int32)
+    right = np.ascontiguousarray(right, dtype=np.int32)
+    value = np.ascontiguousarray(value, dtype=np.float32)
+    if value.ndim == 1:
+        value = value.reshape(-1, 1)
+    if not (feature.shape == left.shape == right.shape) or feature.ndim != 1 or value.shape[0] != len(feature):
+        raise ValueError("The tree arrays must have one entry per node")
+    if len(feature) == 0 or value.shape[1] == 0:
+        raise ValueError("The tree has no node")
+    cdef int [::1] feature_view = feature
+    cdef int [::1] left_view = left
+    cdef int [::1] right_view = right
+    cdef float [:, ::1] value_view = value
+    return new CompleteTree(&feature_view[0], &left_view[0], &right_view[0], &value_view[0][0], len(feature), value.shape[1])
+
+
+def complete_tree(feature, left, right, value):
+    """Returns the tree given by the flat arrays (value has a row of values per node) as a complete tree of its depth:
+    the feature tested by each internal position i, whose children are 2i+1 (feature set) and 2i+2, and the values of
+    each leaf position. The leaves shallower than the depth are repeated below them"""
+    cdef CompleteTree *tree = _new_complete_tree(feature, left, right, value)
+    try:
+        return {"depth": tree.depth,
+                "feature": np.asarray(tree.feature, dtype=np.int32),
+                "value": np.asarray(tree.value, dtype=np.float32).reshape(1 << tree.depth, -1)}
+    finally:
+        del tree
+
+
+def tree_to_cpp(feature, left, right, value, name, conditional=False):
+    """Returns a self-contained C++ header defining the function "const float *name(const int *x)", which returns the
+    values of the leaf reached by the row x of binary features. The function loops over the complete tree stored in
+    arrays (see complete_tree), or is a nest of conditionals following the tree when conditional is set"""
+    cdef CompleteTree *tree = _new_complete_tree(feature, left, right, value)
+    try:
+        return tree.toCppHeader(str(name).encode("utf-8"), conditional).decode("utf-8")
+    finally:
+        del tree
+
+
+cdef extern from "../core/src/forest.h":
+    cdef cppclass Forest:
+        vector[int] roots
+        vector[float] errors
+        Tree nodes
+
+    void searchForest(float *supports, int ntransactions, int nattributes, int nclasses, int *data, int *target,
+                      int ntrees, const float *sample_weights, const int *sample_masks, int max_features, unsigned seed,
+                      int maxdepth, int minsup, int timeLimit, float *reg_target, bool use_threads, Forest *forest) nogil except +
+
+
+def solve_forest(data, target, n_trees, sample_weights=None, max_features=0, seed=0, max_depth=1, min_sup=1,
+                 time_limit=0, reg_target=None, use_threads=True, sample_masks=None):
+    """Learns n_trees optimal trees on the same binary data, loaded once and shared by the searches, which run in
+    parallel when use_threads is set. sample_weights has one row of example weights per tree (e.g. the multiplicities
+    of a bootstrap sample); the examples of null weight are out of the sample of the tree. sample_masks has one row of
+    boolean flags per tree (e.g. the training examples of the folds of a cross-validation); the examples out of the
+    mask are out of the sample of the tree. Each tree tests max_features features drawn at random with the seed (all of
+    them for 0). The trees minimize the misclassification of the labels target (from 0 to n_classes - 1), or the squared
+    error of reg_target when it is given. Returns the trees stored one after the other in flat arrays with global node
+    indexes ("feature", "left", "right", "value", "error"), the index of the root of each tree ("roots", -1 for an
+    empty sample) and the training error of each tree ("errors")"""
+    data = np.asarray(data)
+    if data.ndim != 2 or not np.array_equal(data, data.astype(bool)):
+        raise ValueError("Bad input type. DL8.5 actually only supports binary (0/1) inputs")
+    cdef int ntransactions = data.shape[0]
+    cdef int nattributes = data.shape[1]
+    if ntransactions == 0 or n_trees < 1:
+        raise ValueError("The forest needs examples and at least one tree")
+    cdef int [:, ::1] data_view = np.ascontiguousarray(data.T, dtype=np.int32)
+
+    cdef int [::1] target_view
+    cdef int *target_pointer = NULL
+    cdef float [::1] reg_target_view
+    cdef float *reg_target_pointer = NULL
+    supports = np.zeros(1, dtype=np.float32)
+    if reg_target is not None:
+        reg_target_view = np.ascontiguousarray(reg_target, dtype=np.float32).ravel()
+        if reg_target_view.shape[0] != ntransactions:
+            raise ValueError("The forest supports one numerical target per example")
+        reg_target_pointer = &reg_target_view[0]
+    else:
+        target = np.ascontiguousarray(target, dtype=np.int32)
+        if target.shape != (ntransactions,) or target.min() < 0:
+            raise ValueError("The labels must be one integer between 0 and n_classes - 1 per example")
+        supports = np.bincount(target).astype(np.float32)
+        target_view = target
+        target_pointer = &target_view[0]
+    cdef float [::1] supports_view = supports
+
+    cdef float [:, ::1] weights_view
+    cdef float *weights_pointer = NULL
+    if sample_weights is not None:
+        weights_view = np.ascontiguousarray(sample_weights, dtype=np.float32)
+        if weights_view.shape[0] != n_trees or weights_view.shape[1] != ntransactions:
+            raise ValueError("The sample weights must have the shape (n_trees, n_examples) = " + str((n_trees, ntransactions)))
+        weights_pointer = &weights_view[0][0]
+
+    cdef int [:, ::1] masks_view
+    cdef int *masks_pointer = NULL
+    if sample_masks is not None:
+        masks_view = np.ascontiguousarray(np.asarray(sample_masks) != 0, dtype=np.int32)
+        if masks_view.shape[0] != n_trees or masks_view.shape[1] != ntransactions:
+            raise ValueError("The sample masks must have the shape (n_trees, n_examples) = " + str((n_trees, ntransactions)))
+        masks_pointer = &masks_view[0][0]
+
+    cdef FlatTree flat = FlatTree()
+    cdef Forest forest
+    cdef int nclasses = len(supports)
+    cdef int ntrees = n_trees
+    cdef int features = max_features
+    cdef unsigned random_seed = seed
+    cdef int maxdepth = max_depth
+    cdef int minsup = min_sup
+    cdef int timeLimit = time_limit
+    cdef bool threads = use_threads
+    with nogil:
+        searchForest(&supports_view[0], ntransactions, nattributes, nclasses, &data_view[0][0], target_pointer, ntrees,
+                     weights_pointer, masks_pointer, features, random_seed, maxdepth, minsup, timeLimit,
+                     reg_target_pointer, threads, &forest)
+    flat.tree = forest.nodes
+    arrays = flat.arrays()
+    return {"feature": arrays["feature"], "left": arrays["left"], "right": arrays["right"], "value": arrays["value"],
+            "error": arrays["error"], "roots": np.asarray(forest.roots, dtype=np.int32),
+            "errors": np.asarray(forest.errors, dtype=np.float32)}
+
+
+cdef extern from "../core/src/incrementalSearch.h":
+    cdef cppclass IncrementalSearch:
+        IncrementalSearch(int nattributes, int nclasses, int maxdepth, int minsup, int timeLimit) except +
+        void addTransactions(int *data, int *target, int ntransactions) except +
+        string search(Tree *tree) nogil except +
+        void getTransactions(int *data, int *target)
+        int getNTransactions()
+
+
+def _rebuild_incremental_solver(params, data, target):
+    solver = IncrementalSolver(*params)
+    solver.add(data, target)
+    return solver
+
+
+cdef class IncrementalSolver:
+    """Learns the optimal tree of binary data growing by batches of examples. The examples are appended to the packed
+    data and each solve searches all of them again, starting from the bounds and the tree of the previous one (see
+    IncrementalSearch)"""
+    cdef IncrementalSearch *search
+    cdef tuple params
+
+    def __cinit__(self, n_features, n_classes, max_depth=1, min_sup=1, time_limit=0):
+        self.search = new IncrementalSearch(n_features, n_classes, max_depth, min_sup, time_limit)
+        self.params = (n_features, n_classes, max_depth, min_sup, time_limit)
+
+    def __dealloc__(self):
+        del self.search
+
+    def __reduce__(self):
+        """The solver is pickled (or copied) with the examples added so far. The bounds of the previous search are not
+        kept, so the first solve of the copy searches from scratch"""
+        cdef int n = self.search.getNTransactions()
+        data = np.zeros((self.params[0], n), dtype=np.int32)
+        target = np.zeros(n, dtype=np.int32)
+        cdef int [:, ::1] data_view = data
+        cdef int [::1] target_view = target
+        if n > 0:
+            self.search.getTransactions(&data_view[0][0], &target_view[0])
+        return _rebuild_incremental_solver, (self.params, data.T, target)
+
+    @property
+    def n_examples(self):
+        return self.search.getNTransactions()
+
+    def add(self, data, target):
+        """Appends the examples of the binary data and their classes target (from 0 to n_classes - 1)"""
+        data = np.asarray(data)
+        if data.ndim != 2 or not np.array_equal(data, data.astype(bool)):
+            raise ValueError("Bad input type. DL8.5 actually only supports binary (0/1) inputs")
+        target = np.ascontiguousarray(target, dtype=np.int32)
+        if target.shape != (data.shape[0],):
+            raise ValueError("The target must have one class per example")
+        if data.shape[0] == 0:
+            return
+        cdef int [:, ::1] data_view = np.ascontiguousarray(data.T, dtype=np.int32)
+        cdef int [::1] target_view = target
+        self.search.addTransactions(&data_view[0][0], &target_view[0], data.shape[0])
+
+    def solve(self):
+        """Returns the description of the optimal tree of all the examples added so far and its arrays, as
+        solve(..., flat_tree=True) does"""
+        cdef FlatTree flat = FlatTree()
+        cdef string out
+        with nogil:
+            out = self.search.search(&flat.tree)
+        return out.decode("utf-8"), flat.arrays()
+
 
 cdef extern from "../core/src/dl85.h":
     string search ( float* supports,
@@ -62,7 +481,23 @@ cdef extern from "../core/src/dl85.h":
                     int timeLimit,
                     # map[int, pair[int, int]]* continuousMap,
                     # bool save,
-                    bool verbose_param) except +
+                    bool verbose_param,
+                    NativeError* native_error,
+                    PyBatchErrorClassWrapper batch_error_class_callback,
+                    bool batch_error_class_is_null,
+                    bool batch_on_supports,
+                    int leafCacheSize,
+                    float *reg_target,
+                    int regCriterion,
+                    int nRegTargets,
+                    float *cost_matrix,
+                    float errorDecreaseBound,
+                    int nTargets,
+                    float *target_weights,
+                    Tree *out_tree,
+                    int *root_mask,
+                    const char *trace_file,
+                    const char *tracing_file) except +
 
 
 def solve(data,
@@ -81,11 +516,37 @@ def solve(data,
           desc=False,
           asc=False,
           repeat_sort=False,
+          error_plugin=None,
+          batch=False,
+          error_cache_size=0,
+          reg_target=None,
+          reg_criterion="mse",
+          cost_matrix=None,
+          error_decrease_bound=None,
+          target_weights=None,
+          flat_tree=False,
+          root_mask=None,
+          trace_file=None,
+          tracing_file=None,
           # continuousMap=None,
           # bin_save=False,
           # predictor=False
           ):
 
+    # in batch mode, the python error function is called once for all the children of a node instead of once per node
+    batch_func_, batch_on_supports = None, False
+    if batch:
+        if sec_func_ is not None:
+            batch_func_, batch_on_supports = sec_func_, True
+        else:
+            batch_func_ = tec_func_ if tec_func_ is not None else te_func_
+        tec_func_, sec_func_, te_func_ = None, None, None
+
+    cdef PyBatchErrorClassWrapper batch_func = PyBatchErrorClassWrapper(batch_func_)
+    batch_null_flag = True
+    if batch_func_ is not None:
+        batch_null_flag = False
+
     cdef PyTidErrorClassWrapper tec_func = PyTidErrorClassWrapper(tec_func_)
     tec_null_flag = True
     if tec_func_ is not None:
@@ -120,8 +581,13 @@ def solve(data,
     # get pointer form target
     cdef int [::1] target_view
     cdef int *target_array = NULL
+    n_targets = 1
     if target is not None:
         target = target.astype('int32')
+        # the columns of a multi-target classification are stored one after the other
+        if target.ndim == 2:
+            n_targets = target.shape[1]
+            target = target.T.ravel()
         if not target.flags['C_CONTIGUOUS']:
             target = np.ascontiguousarray(target) # Makes a contiguous copy of the numpy array.
         target_view = target
@@ -146,6 +612,66 @@ def solve(data,
         ex_weights_view = ex_weights
         ex_weights_pointer = &ex_weights_view[0]
 
+    # get pointer from the numerical target of a regression. A 2D target has one row per example (e.g. clustering)
+    cdef float [::1] reg_target_view
+    cdef float *reg_target_pointer = NULL
+    n_reg_targets = 1
+    criteria = {"mse": 0, "mae": 1}
+    if reg_target is not None:
+        if reg_criterion not in criteria:
+            raise ValueError("Unknown regression criterion " + str(reg_criterion) + ". Expected one of " + str(list(criteria)))
+        reg_target = np.ascontiguousarray(reg_target, dtype=np.float32)
+        if reg_target.ndim == 2:
+            n_reg_targets = reg_target.shape[1]
+        reg_target_view = reg_target.ravel()
+        reg_target_pointer = &reg_target_view[0]
+
+    # get pointer from the cost matrix. The rows are the real classes and the columns the predicted ones
+    cdef float [::1] cost_matrix_view
+    cdef float *cost_matrix_pointer = NULL
+    if cost_matrix is not None:
+        cost_matrix = np.ascontiguousarray(cost_matrix, dtype=np.float32)
+        if cost_matrix.shape != (nclasses, nclasses):
+            raise ValueError("The cost matrix must have the shape (n_classes, n_classes) = " + str((nclasses, nclasses)))
+        if not np.all(cost_matrix >= 0):
+            raise ValueError("The costs of the cost matrix must be positive or zero, and not NaN")
+        cost_matrix_view = cost_matrix.ravel()
+        cost_matrix_pointer = &cost_matrix_view[0]
+
+    # get pointer from the weights of the errors of the targets of a multi-target classification
+    cdef float [::1] target_weights_view
+    cdef float *target_weights_pointer = NULL
+    if target_weights is not None:
+        target_weights = np.ascontiguousarray(target_weights, dtype=np.float32)
+        if target_weights.shape != (n_targets,):
+            raise ValueError("The target weights must have the shape (n_targets,) = " + str((n_targets,)))
+        target_weights_view = target_weights
+        target_weights_pointer = &target_weights_view[0]
+
+    # get pointer from the flags of the examples searched. The others stay in the packed data but out of the root cover
+    cdef int [::1] root_mask_view
+    cdef int *root_mask_pointer = NULL
+    if root_mask is not None:
+        root_mask = np.ascontiguousarray(np.asarray(root_mask) != 0, dtype=np.int32)
+        if root_mask.shape != (ntransactions,):
+            raise ValueError("The root mask must have the shape (n_examples,) = " + str((ntransactions,)))
+        root_mask_view = root_mask
+        root_mask_pointer = &root_mask_view[0]
+
+    # the cover and cache operations of the search are recorded in this file, to be replayed by dl85_trace_replay
+    cdef string trace_path
+    cdef const char *trace_file_pointer = NULL
+    if trace_file is not None:
+        trace_path = str(trace_file).encode("utf-8")
+        trace_file_pointer = trace_path.c_str()
+
+    # the events of the search (see tracing.h) are written in this file, read by chrome://tracing and Perfetto
+    cdef string tracing_path
+    cdef const char *tracing_file_pointer = NULL
+    if tracing_file is not None:
+        tracing_path = str(tracing_file).encode("utf-8")
+        tracing_file_pointer = tracing_path.c_str()
+
     # max_err = max_error - 1  # because maxError but not be reached
     if max_error < 0:  # raise error when incompatibility between max_error value and stop_after_better value
         stop_after_better = False
@@ -159,30 +685,63 @@ def solve(data,
 
     # pred = not predictor
 
-    out = search(supports = &supports_view[0],
-                 ntransactions = ntransactions,
-                 nattributes = nattributes,
-                 nclasses = nclasses,
-                 data = data_matrix,
-                 target = target_array,
-                 maxdepth = max_depth,
-                 minsup = min_sup,
-                 maxError = max_error,
-                 stopAfterError = stop_after_better,
-                 # iterative = iterative,
-                 tids_error_class_callback = tec_func,
-                 supports_error_class_callback = sec_func,
-                 tids_error_callback = te_func,
-                 in_weights = ex_weights_pointer,
-                 tids_error_class_is_null = tec_null_flag,
-                 supports_error_class_is_null = sec_null_flag,
-                 tids_error_is_null = te_null_flag,
-                 infoGain = info_gain,
-                 infoAsc = asc,
-                 repeatSort = repeat_sort,
-                 timeLimit = time_limit,
-                 # continuousMap = NULL,
-                 # save = bin_save,
-                 verbose_param = verb)
+    # the tree is also returned as arrays (feature, left, right, value and error of the nodes in preorder)
+    cdef FlatTree flat = None
+    cdef Tree *out_tree_pointer = NULL
+    if flat_tree:
+        flat = FlatTree()
+        out_tree_pointer = &flat.tree
+
+    # load the native error function from the shared object if it is provided
+    cdef NativeError* native_error = NULL
+    if error_plugin is not None:
+        native_error = new PluginError(str(error_plugin).encode("utf-8"))
+
+    try:
+        out = search(supports = &supports_view[0],
+                     ntransactions = ntransactions,
+                     nattributes = nattributes,
+                     nclasses = nclasses,
+                     data = data_matrix,
+                     target = target_array,
+                     maxdepth = max_depth,
+                     minsup = min_sup,
+                     maxError = max_error,
+                     stopAfterError = stop_after_better,
+                     # iterative = iterative,
+                     tids_error_class_callback = tec_func,
+                     supports_error_class_callback = sec_func,
+                     tids_error_callback = te_func,
+                     in_weights = ex_weights_pointer,
+                     tids_error_class_is_null = tec_null_flag,
+                     supports_error_class_is_null = sec_null_flag,
+                     tids_error_is_null = te_null_flag,
+                     infoGain = info_gain,
+                     infoAsc = asc,
+                     repeatSort = repeat_sort,
+                     timeLimit = time_limit,
+                     # continuousMap = NULL,
+                     # save = bin_save,
+                     verbose_param = verb,
+                     native_error = native_error,
+                     batch_error_class_callback = batch_func,
+                     batch_error_class_is_null = batch_null_flag,
+                     batch_on_supports = batch_on_supports,
+                     leafCacheSize = error_cache_size,
+                     reg_target = reg_target_pointer,
+                     regCriterion = criteria.get(reg_criterion, 0),
+                     nRegTargets = n_reg_targets,
+                     cost_matrix = cost_matrix_pointer,
+                     errorDecreaseBound = error_decrease_bound if error_decrease_bound is not None else 0,
+                     nTargets = n_targets,
+                     target_weights = target_weights_pointer,
+                     out_tree = out_tree_pointer,
+                     root_mask = root_mask_pointer,
+                     trace_file = trace_file_pointer,
+                     tracing_file = tracing_file_pointer)
+    finally:
+        del native_error
 
+    if flat_tree:
+        return out.decode("utf-8"), flat.arrays()
     return out.decode("utf-8")
\ No newline at end of file
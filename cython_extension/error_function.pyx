@@ -2,7 +2,9 @@ from libcpp cimport bool
 from libcpp.string cimport string
 from libcpp.vector cimport vector
 from libcpp.stack cimport stack
+from libc.string cimport memcpy
 from cython.operator cimport dereference as deref, preincrement as inc
+import numpy as np
 
 cdef extern from "../core/src/dataManager.h":
     cdef cppclass DataManager:
@@ -22,6 +24,14 @@ cdef extern from "../core/src/rCover.h":
         DataManager* dm
         stack[int] limit
 
+cdef extern from "../core/src/query.h":
+    cdef cppclass LeafBatch:
+        bool use_supports
+        vector[int] tids
+        vector[int] indptr
+        vector[float] supports
+        int size()
+
 cdef class ArrayIterator:
     cdef RCover* arr
     cdef RCover.iterator it
@@ -61,9 +71,50 @@ cdef public wrap_array(RCover *ar, bool trans):
 cdef public vector[float] call_python_tid_error_class_function(py_function, RCover *ar):
     return py_function(wrap_array(ar, True))
 
-cdef public vector[float] call_python_support_error_class_function(py_function, RCover *ar):
-    return py_function(wrap_array(ar, False))
+cdef class SupportsBuffer:
+    # numpy array given to the fast error functions. It is refilled with the supports per class of each node, so
+    # that no python object is created per call
+    cdef object array
+    cdef float *data
+
+    def __cinit__(self, int nclasses):
+        self.array = np.zeros(nclasses, dtype=np.float32)
+        cdef float [::1] view = self.array
+        self.data = &view[0]
+
+cdef public object new_supports_buffer(int nclasses):
+    return SupportsBuffer(nclasses)
+
+cdef public void call_python_support_error_class_function(py_function, supports_buffer, float *supports, int nclasses, float *out):
+    cdef SupportsBuffer buffer = <SupportsBuffer> supports_buffer
+    memcpy(buffer.data, supports, nclasses * sizeof(float))
+    # the function returns the error and the class of the node, and optionally a lower bound of the error of any tree
+    # built on the node
+    result = py_function(buffer.array)
+    out[0] = result[0]
+    out[1] = result[1]
+    if len(result) > 2:
+        out[2] = result[2]
 
 cdef public float call_python_tid_error_function(py_function, RCover *ar):
     return py_function(wrap_array(ar, True))
 
+cdef public vector[float] call_python_batch_error_class_function(py_function, LeafBatch *batch):
+    cdef int nleaves = batch.size()
+    cdef int ncols
+    # the numpy arrays are views on the batch memory. They are only valid during the call
+    if batch.use_supports:
+        ncols = batch.supports.size() // nleaves
+        result = py_function(np.asarray(<float[:nleaves, :ncols]> batch.supports.data()))
+    else:
+        result = py_function(np.asarray(<int[:nleaves + 1]> batch.indptr.data()),
+                             np.asarray(<int[:batch.tids.size()]> batch.tids.data()))
+
+    # the function returns the errors and the classes of the leaves or only their errors. The classes may be followed by
+    # lower bounds of the errors of the trees built on the leaves
+    if isinstance(result, tuple):
+        result = np.concatenate([np.asarray(values, dtype=np.float32) for values in result])
+    cdef float [::1] values = np.ascontiguousarray(result, dtype=np.float32)
+    cdef vector[float] infos
+    infos.assign(&values[0], &values[0] + values.shape[0])
+    return infos
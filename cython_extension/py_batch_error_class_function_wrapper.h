@@ -0,0 +1,52 @@
+#ifndef DL85_PY_BATCH_ERROR_WRAPPER_H
+#define DL85_PY_BATCH_ERROR_WRAPPER_H
+
+#include <Python.h>
+#include "query.h"
+#include "error_function.h" // cython helper file
+
+class PyBatchErrorClassWrapper {
+public:
+    // constructors and destructors mostly do reference counting
+    PyBatchErrorClassWrapper(PyObject* o): pyFunction(o) {
+        Py_XINCREF(o);
+    }
+
+    PyBatchErrorClassWrapper(const PyBatchErrorClassWrapper& rhs): PyBatchErrorClassWrapper(rhs.pyFunction) { // C++11 onwards only
+    }
+
+    PyBatchErrorClassWrapper(PyBatchErrorClassWrapper&& rhs): pyFunction(rhs.pyFunction) {
+        rhs.pyFunction = nullptr;
+    }
+
+    // need no-arg constructor to stack allocate in Cython
+    PyBatchErrorClassWrapper(): PyBatchErrorClassWrapper(nullptr) {
+    }
+
+    ~PyBatchErrorClassWrapper() {
+        Py_XDECREF(pyFunction);
+    }
+
+    PyBatchErrorClassWrapper& operator=(const PyBatchErrorClassWrapper& rhs) {
+        PyBatchErrorClassWrapper tmp = rhs;
+        return (*this = std::move(tmp));
+    }
+
+    PyBatchErrorClassWrapper& operator=(PyBatchErrorClassWrapper&& rhs) {
+        pyFunction = rhs.pyFunction;
+        rhs.pyFunction = nullptr;
+        return *this;
+    }
+
+    vector<float> operator()(LeafBatch* batch) {
+        PyInit_error_function();
+        if (pyFunction) { // nullptr check
+            return call_python_batch_error_class_function(pyFunction, batch); // note, no way of checking for errors until you return to Python
+        }
+    }
+
+private:
+    PyObject* pyFunction;
+};
+
+#endif //DL85_PY_BATCH_ERROR_WRAPPER_H
@@ -16,11 +16,13 @@ public:
         Py_XINCREF(o);
     }
 
+    // the copy allocates its own buffer at its first call
     PySupportErrorClassWrapper(const PySupportErrorClassWrapper& rhs): PySupportErrorClassWrapper(rhs.pyFunction) { // C++11 onwards only
     }
 
-    PySupportErrorClassWrapper(PySupportErrorClassWrapper&& rhs): pyFunction(rhs.pyFunction) {
+    PySupportErrorClassWrapper(PySupportErrorClassWrapper&& rhs): pyFunction(rhs.pyFunction), supportsBuffer(rhs.supportsBuffer) {
         rhs.pyFunction = nullptr;
+        rhs.supportsBuffer = nullptr;
     }
 
     // need no-arg constructor to stack allocate in Cython
@@ -29,6 +31,7 @@ public:
 
     ~PySupportErrorClassWrapper() {
         Py_XDECREF(pyFunction);
+        Py_XDECREF(supportsBuffer);
     }
 
     PySupportErrorClassWrapper& operator=(const PySupportErrorClassWrapper& rhs) {
@@ -37,20 +40,27 @@ public:
     }
 
     PySupportErrorClassWrapper& operator=(PySupportErrorClassWrapper&& rhs) {
+        Py_XDECREF(pyFunction);
+        Py_XDECREF(supportsBuffer);
         pyFunction = rhs.pyFunction;
+        supportsBuffer = rhs.supportsBuffer;
         rhs.pyFunction = nullptr;
+        rhs.supportsBuffer = nullptr;
         return *this;
     }
 
-    vector<float> operator()(RCover* ar) {
+    void operator()(Supports supports, float* out) {
         PyInit_error_function();
         if (pyFunction) { // nullptr check
-            return call_python_support_error_class_function(pyFunction, ar); // note, no way of checking for errors until you return to Python
+            // the numpy array given to the python function is allocated once and refilled at each call
+            if (!supportsBuffer) supportsBuffer = new_supports_buffer(nclasses);
+            call_python_support_error_class_function(pyFunction, supportsBuffer, supports, nclasses, out); // note, no way of checking for errors until you return to Python
         }
     }
 
 private:
     PyObject* pyFunction;
+    PyObject* supportsBuffer = nullptr;
 };
 
 #endif //DL85_PY_FAST_ERROR_WRAPPER_H
@@ -1,7 +1,10 @@
 from .supervised.classifiers.classifier import DL85Classifier
+from .supervised.classifiers.forest import DL85ForestClassifier
+from .supervised.classifiers.validation import cross_val_score
 from .supervised.classifiers.boosting import DL85Booster, MODEL_LP_RATSCH, MODEL_LP_DEMIRIZ, MODEL_QP_MDBOOST
+from .supervised.regressors.regressor import DL85Regressor
 from .predictors.predictor import DL85Predictor
 from .unsupervised.clustering import DL85Cluster
 from ._version import __version__
 
-__all__ = ['__version__', 'DL85Predictor', 'DL85Classifier', 'DL85Booster', 'DL85Cluster']
+__all__ = ['__version__', 'DL85Predictor', 'DL85Classifier', 'DL85Booster', 'DL85ForestClassifier', 'cross_val_score', 'DL85Regressor', 'DL85Cluster']
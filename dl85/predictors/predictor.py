@@ -62,6 +62,18 @@ class DL85Predictor(BaseEstimator):
         A parameter used to indicate whether the heuristic sort will be applied at each level of the lattice or only at the root
     print_output : bool, default=False
         A parameter used to indicate if the search output will be printed or not
+    error_plugin : str, default=None
+        Path of a shared object implementing the error function in C++. See the user guide for the expected symbols
+    batch_error : bool, default=False
+        Whether error_function and fast_error_function are called once per batch of sibling nodes instead of once per node
+    error_cache_size : int, default=0
+        Maximum number of results of error_function and fast_error_function memorized by cover, so that a cover reached through several paths is evaluated once. 0 disables the memorization
+    cost_matrix : array-like, shape (n_classes, n_classes), default=None
+        Cost of predicting the class of the column for an example of the class of the row. When it is provided, the total cost is minimized instead of the number of misclassified examples, at the same speed. The costs must be positive or zero
+    error_decrease_bound : float, default=None
+        Highest decrease of the value of error_function or fast_error_function on a set of examples when one example of unit weight is removed from it. When it is provided, the similarity lower bound prunes the search with these functions. A wrong value may lead to a suboptimal tree
+    target_weights : array-like, shape (n_targets,), default=None
+        Weight of the misclassification error of each target when y has several columns. A single tree predicting all the targets is then learnt with one search; the error functions are not used. Default value stands for unit weights
 
     Attributes
     ----------
@@ -79,10 +91,22 @@ class DL85Predictor(BaseEstimator):
         The number of nodes explored before found the optimal tree
     runtime_ : float
         Time of the optimal decision tree search
+    search_stats_ : dict
+        Where the time of the search went and how many nodes each rule pruned: the times in seconds spent computing
+        the candidate attributes, intersecting covers, counting and selecting the trees of depth 2, inserting in the
+        cache, computing bounds and calling the python error functions, and the counts of trees of depth 2, cache hits
+        and nodes pruned as infeasible, as reaching their lower bound, by canSkip and by the minimum support. The times
+        of the intersections, cache inserts and bounds are 0 unless the library is built with DL85_STATS_TIMERS
     timeout_ : bool
         Whether the search reached timeout or not
     classes_ : ndarray, shape (n_classes,)
         The classes seen at :meth:`fit`.
+    sklearn_arrays_ : dict
+        The tree found as the arrays of scikit-learn trees (children_left, children_right, feature, threshold,
+        impurity, value, n_node_samples and weighted_n_node_samples), filled by the search from the covers of the nodes.
+        The left child is the one of the examples not having the feature (threshold 0.5). The value of a node is the
+        (weighted) support of each class, or its prediction as a leaf for the regression. The impurity is the gini
+        impurity of the classes, and 0 for the regression
     """
 
     def __init__(
@@ -100,7 +124,13 @@ class DL85Predictor(BaseEstimator):
             repeat_sort=False,
             leaf_value_function=None,
             quiet=True,
-            print_output=False):
+            print_output=False,
+            error_plugin=None,
+            batch_error=False,
+            error_cache_size=0,
+            cost_matrix=None,
+            error_decrease_bound=None,
+            target_weights=None):
         self.max_depth = max_depth
         self.min_sup = min_sup
         self.sample_weight = []
@@ -116,6 +146,12 @@ class DL85Predictor(BaseEstimator):
         self.leaf_value_function = leaf_value_function
         self.quiet = quiet
         self.print_output = print_output
+        self.error_plugin = error_plugin
+        self.batch_error = batch_error
+        self.error_cache_size = error_cache_size
+        self.cost_matrix = cost_matrix
+        self.error_decrease_bound = error_decrease_bound
+        self.target_weights = target_weights
 
         self.tree_ = None
         self.size_ = -1
@@ -124,8 +160,10 @@ class DL85Predictor(BaseEstimator):
         self.accuracy_ = -1
         self.lattice_size_ = -1
         self.runtime_ = -1
+        self.search_stats_ = None
         self.timeout_ = False
         self.classes_ = []
+        self.sklearn_arrays_ = None
         self.is_fitted_ = False
 
     def _more_tags(self):
@@ -149,6 +187,9 @@ class DL85Predictor(BaseEstimator):
         """
 
         target_is_need = True if y is not None else False
+        multi_target = False
+        # regressors (see DL85Regressor) learn from a numerical target with a native criterion
+        regression = getattr(self, '_estimator_type', None) == 'regressor'
         opt_func = self.error_function
         opt_fast_func = self.fast_error_function
         opt_pred_func = self.error_function
@@ -156,7 +197,11 @@ class DL85Predictor(BaseEstimator):
 
         if target_is_need:  # target-needed tasks (eg: classification, regression, etc.)
             # Check that X and y have correct shape and raise ValueError if not
-            X, y = check_X_y(X, y, dtype='int32')
+            X, y = check_X_y(X, y, dtype='int32', y_numeric=regression, multi_output=True)
+            if y.ndim == 2 and y.shape[1] == 1:
+                y = y.ravel()
+            # several target columns are predicted by a single tree
+            multi_target = y.ndim == 2 and not regression
             if self.leaf_value_function is None:
                 opt_pred_func = None
                 predict = False
@@ -176,11 +221,14 @@ class DL85Predictor(BaseEstimator):
                 opt_func = None
                 opt_fast_func = None
 
+        # numerical targets of the errors computed in C++ (regression, clustering)
+        native_target = self._native_target(X, y)
+
         # sys.path.insert(0, "../../")
         import dl85Optimizer
         # print(opt_func)
         solution = dl85Optimizer.solve(data=X,
-                                       target=y,
+                                       target=None if native_target is not None else y,
                                        tec_func_=opt_func,
                                        sec_func_=opt_fast_func,
                                        te_func_=opt_pred_func,
@@ -193,7 +241,18 @@ class DL85Predictor(BaseEstimator):
                                        verb=self.verbose,
                                        desc=self.desc,
                                        asc=self.asc,
-                                       repeat_sort=self.repeat_sort)
+                                       repeat_sort=self.repeat_sort,
+                                       error_plugin=self.error_plugin,
+                                       batch=self.batch_error,
+                                       error_cache_size=self.error_cache_size,
+                                       reg_target=native_target,
+                                       reg_criterion=self._native_criterion(),
+                                       cost_matrix=self.cost_matrix,
+                                       error_decrease_bound=self.error_decrease_bound,
+                                       target_weights=self.target_weights,
+                                       flat_tree=True)
+        solution, tree_arrays = solution
+        self.search_stats_ = tree_arrays["stats"]
 
         # if self.print_output:
         #     print(solution)
@@ -202,13 +261,8 @@ class DL85Predictor(BaseEstimator):
         self.sol_size = len(solution)
 
         if self.sol_size == 9:  # solution found
-            self.tree_ = json.loads(solution[1].split('Tree: ')[1])
-            self.size_ = int(solution[2].split(" ")[1])
-            self.depth_ = int(solution[3].split(" ")[1])
-            self.error_ = float(solution[4].split(" ")[1])
-            self.lattice_size_ = int(solution[6].split(" ")[1])
-            self.runtime_ = float(solution[7].split(" ")[1])
-            self.timeout_ = bool(strtobool(solution[8].split(" ")[1]))
+            self.tree_ = self._tree_from_arrays(tree_arrays, integer_values=native_target is None)
+            self._read_solution(solution)
             if self.size_ >= 3 or self.max_error <= 0:
                 self.accuracy_ = float(solution[5].split(" ")[1])
 
@@ -228,9 +282,12 @@ class DL85Predictor(BaseEstimator):
                     else:
                         print("DL8.5 fitting: Timeout reached but solution found")
 
-            if target_is_need:  # problem with target
-                # Store the classes seen during fit
-                self.classes_ = unique_labels(y)
+            if target_is_need and not regression:  # problem with target
+                # Store the classes seen during fit. There is an array of classes per target with several targets
+                self.classes_ = [unique_labels(y[:, t]) for t in range(y.shape[1])] if multi_target else unique_labels(y)
+
+            self.sklearn_arrays_ = self._sklearn_arrays(tree_arrays, None if native_target is not None or y is None
+                                                        else self.classes_, multi_target)
 
         elif self.sol_size == 5:  # solution not found
             self.lattice_size_ = int(solution[2].split(" ")[1])
@@ -242,10 +299,14 @@ class DL85Predictor(BaseEstimator):
                 print("DL8.5 fitting: Timeout reached and solution not found")
 
         if hasattr(self, 'tree_') and self.tree_ is not None:
-            # add transactions to nodes of the tree
-            self.add_transactions_and_proba(X, y)
+            # the class supports of the nodes come with the tree found, so the probabilities need no pass over the data
+            self._add_proba(None if multi_target or y is None or native_target is not None
+                            else self.sklearn_arrays_["value"][:, 0, :])
 
             if self.leaf_value_function is not None:
+                # add transactions to nodes of the tree. The search gives the leaf of each example
+                self._add_transactions_from_leaves(tree_arrays["transaction_leaf"])
+
                 def search(node):
                     if self.is_leaf_node(node) is not True:
                         search(node['left'])
@@ -255,7 +316,7 @@ class DL85Predictor(BaseEstimator):
                 node = self.tree_
                 search(node)
 
-            self.remove_transactions()
+                self.remove_transactions()
 
         if self.print_output:
             print(solution[0])
@@ -272,6 +333,92 @@ class DL85Predictor(BaseEstimator):
         self.is_fitted_ = True
         return self
 
+    def _read_solution(self, solution):
+        """Sets the size, depth, error, lattice size, runtime and timeout of the tree found from the lines of the
+        description returned by the search."""
+        self.size_ = int(solution[2].split(" ")[1])
+        self.depth_ = int(solution[3].split(" ")[1])
+        self.error_ = float(solution[4].split(" ")[1])
+        self.lattice_size_ = int(solution[6].split(" ")[1])
+        self.runtime_ = float(solution[7].split(" ")[1])
+        self.timeout_ = bool(strtobool(solution[8].split(" ")[1]))
+
+    @staticmethod
+    def _tree_from_arrays(arrays, integer_values=True):
+        """Builds the dict representation of a tree from the arrays returned by the search, whose nodes are numbered in
+        preorder. A leaf has the feature -1 and its values are NaN when they are not known."""
+        feature, left, right, value, error = (arrays[key] for key in ("feature", "left", "right", "value", "error"))
+        cast = int if integer_values else float
+
+        def leaf_value(values):
+            if np.isnan(values).any():
+                return "undefined"
+            return cast(values) if np.ndim(values) == 0 else [cast(v) for v in values]
+
+        def node(i):
+            if feature[i] < 0:
+                return {"value": leaf_value(value[i]), "error": float(error[i])}
+            return {"feat": int(feature[i]), "left": node(left[i]), "right": node(right[i])}
+
+        return node(0)
+
+    @staticmethod
+    def _sklearn_arrays(arrays, classes=None, multi_target=False):
+        """Builds the arrays of scikit-learn trees from the arrays returned by the search. The class k of the search is
+        the label k; with several targets, the classes of the target t follow the ones of the previous targets, each
+        target having max(2, max label + 1) classes. The value of a node is the distribution of the search when there
+        is no class."""
+        feature, left, right = arrays["feature"], arrays["left"], arrays["right"]
+        internal = feature >= 0
+        distribution = np.asarray(arrays["distribution"], dtype=np.float64).reshape(len(feature), -1)
+
+        def class_columns(labels, offset):
+            columns = np.zeros((len(feature), len(labels)))
+            for k, label in enumerate(labels):
+                if 0 <= offset + label < distribution.shape[1]:
+                    columns[:, k] = distribution[:, offset + label]
+            return columns
+
+        if classes is None:
+            value = distribution[:, :, np.newaxis]
+        elif multi_target:
+            value = np.zeros((len(feature), len(classes), max(len(labels) for labels in classes)))
+            offset = 0
+            for t, labels in enumerate(classes):
+                value[:, t, :len(labels)] = class_columns(labels, offset)
+                offset += max(2, int(max(labels)) + 1)
+        else:
+            value = class_columns(classes, 0)[:, np.newaxis, :]
+
+        # the gini impurity of the classes, averaged over the targets as in scikit-learn. There is no impurity without
+        # classes
+        impurity = np.zeros(len(feature))
+        if classes is not None:
+            totals = value.sum(axis=2, keepdims=True)
+            frequencies = np.divide(value, totals, out=np.zeros(value.shape), where=totals > 0)
+            impurity = np.where(totals[:, :, 0] > 0, 1 - (frequencies ** 2).sum(axis=2), 0).mean(axis=1)
+
+        return {"node_count": len(feature),
+                "children_left": np.where(internal, right, -1).astype(np.intp),
+                "children_right": np.where(internal, left, -1).astype(np.intp),
+                "feature": np.where(internal, feature, -2).astype(np.intp),
+                "threshold": np.where(internal, 0.5, -2.).astype(np.float64),
+                "impurity": impurity,
+                "value": value,
+                "n_node_samples": np.asarray(arrays["n_node_samples"], dtype=np.intp),
+                "weighted_n_node_samples": np.asarray(arrays["weighted_n_node_samples"], dtype=np.float64)}
+
+    def _native_target(self, X, y):
+        """Returns the numerical targets whose error is computed in C++ without Python callback, or None. The target
+        of the regressors is y; the clustering uses the features of the examples (see DL85Cluster)."""
+        return y if getattr(self, '_estimator_type', None) == 'regressor' else None
+
+    def _native_criterion(self):
+        """Returns the criterion of the error computed in C++ from the targets given by _native_target. The regressors
+        choose it; the clustering minimizes the squared distances of the examples to their centroids, i.e. the squared
+        error on their features."""
+        return self.criterion if getattr(self, '_estimator_type', None) == 'regressor' else 'mse'
+
     def predict(self, X):
         """ Implements the standard predict function for a DL8.5 classifier.
 
@@ -305,12 +452,94 @@ class DL85Predictor(BaseEstimator):
         # Input validation
         X = check_array(X)
 
-        pred = []
+        return self._leaf_entries(X, 'value')
+
+    def _flat_tree(self):
+        """Returns the arrays feature, left and right of the nodes of tree_ numbered in preorder, as returned by the
+        search (see _tree_from_arrays), and the list of the nodes."""
+        feature, left, right, nodes = [], [], [], []
+
+        def visit(node):
+            i = len(nodes)
+            nodes.append(node)
+            feature.append(-1)
+            left.append(-1)
+            right.append(-1)
+            if not self.is_leaf_node(node):
+                feature[i] = node['feat']
+                left[i] = visit(node['left'])
+                right[i] = visit(node['right'])
+            return i
+
+        visit(self.tree_)
+        return feature, left, right, nodes
+
+    def _leaf_entries(self, X, key):
+        """Returns the entry key ('value' or 'proba') of the leaf reached by each row of X. The rows are routed by the
+        native batch predictor, which tests the features of a block of rows at once on bit-packed columns."""
+        import dl85Optimizer
+        feature, left, right, nodes = self._flat_tree()
+        leaves = dl85Optimizer.predict_leaves(X, feature, left, right)
+
+        # the entries of the leaves are gathered in an array indexed by the rank of the leaf
+        leaf_nodes = [i for i, f in enumerate(feature) if f < 0]
+        rank = np.zeros(len(nodes), dtype=np.intp)
+        rank[leaf_nodes] = np.arange(len(leaf_nodes))
+        entries = [nodes[i][key] for i in leaf_nodes]
+        try:
+            table = np.asarray(entries)
+        except ValueError:  # entries of different lengths
+            table = np.empty(len(entries), dtype=object)
+            for i, entry in enumerate(entries):
+                table[i] = entry
+        return table[rank[leaves]]
+
+    def _flat_tree_values(self):
+        """Returns the arrays of _flat_tree with the values of the nodes as an array of floats with a row per node. The
+        internal nodes and the unknown values are NaN."""
+        feature, left, right, nodes = self._flat_tree()
+        leaf_values = [np.atleast_1d(np.asarray(node['value'], dtype=np.float64))
+                       if 'feat' not in node and isinstance(node['value'], (int, float, list, np.number, np.ndarray))
+                       else None for node in nodes]
+        nvalues = max([len(v) for v in leaf_values if v is not None] + [1])
+        value = np.full((len(nodes), nvalues), np.nan, dtype=np.float32)
+        for i, v in enumerate(leaf_values):
+            if v is not None and len(v) == nvalues:
+                value[i] = v
+        return feature, left, right, value
+
+    def export_cpp(self, function_name="dl85_tree", conditional=False):
+        """Exports the tree as a self-contained C++ header for the prediction of one example at a time without
+        Python. The header defines the function "const float *function_name(const int *x)" returning the value(s) of
+        the leaf reached by the example x of binary features. By default, the function routes the example with one
+        test per level and no branch in the complete tree of the depth of the tree, stored in arrays; when
+        conditional is set, it is a nest of conditionals following the tree.
+
+        Parameters
+        ----------
+        function_name : str, default="dl85_tree"
+            The name of the function, a valid C++ identifier
+        conditional : bool, default=False
+            Whether the function is a nest of conditionals instead of the loop over the complete tree
+
+        Returns
+        -------
+        header : str
+            The content of the header
+        """
+        if self.is_fitted_ is False:  # fit method has not been called
+            raise NotFittedError("Call fit method first" % {'name': type(self).__name__})
+
+        if self.tree_ is None:
+            raise TreeNotFoundError("export_cpp(): ", "Tree not found during training by DL8.5 - "
+                                                      "Check fitting message for more info.")
 
-        for i in range(X.shape[0]):
-            pred.append(self.pred_value_on_dict(X[i, :]))
+        if not str(function_name).isidentifier():
+            raise ValueError("The function name must be a valid C++ identifier")
 
-        return pred
+        import dl85Optimizer
+        feature, left, right, value = self._flat_tree_values()
+        return dl85Optimizer.tree_to_cpp(feature, left, right, value, function_name, conditional)
 
     def pred_value_on_dict(self, instance, tree=None):
         node = tree if tree is not None else self.tree_
@@ -322,7 +551,7 @@ class DL85Predictor(BaseEstimator):
         return node['value']
 
     def predict_proba(self, X):
-        """ Implements the standard predict function for a DL8.5 classifier.
+        """ Implements the standard predict_proba function for a DL8.5 classifier.
 
         Parameters
         ----------
@@ -331,9 +560,10 @@ class DL85Predictor(BaseEstimator):
 
         Returns
         -------
-        y : ndarray, shape (n_samples,)
-            The label for each sample is the label of the closest sample
-            seen during fit.
+        p : ndarray, shape (n_samples, n_classes)
+            The probabilities of the classes of classes_ for each sample are the frequencies of these classes among
+            the training samples of its leaf. When fit was given sample_weight, the frequencies are weighted by it, as
+            in scikit-learn.
         """
 
         # Check is fit is called
@@ -351,15 +581,14 @@ class DL85Predictor(BaseEstimator):
             raise SearchFailedError("PredictionError: ", "DL8.5 training has failed. Please contact the developers "
                                                          "if the problem is in the scope supported by the tool.")
 
+        # the leaves of a tree learned on several targets store no probabilities
+        if isinstance(getattr(self, 'classes_', None), list):
+            raise NotImplementedError("predict_proba is not available for a tree learned on several targets")
+
         # Input validation
         X = check_array(X)
 
-        pred = []
-
-        for i in range(X.shape[0]):
-            pred.append(self.pred_proba_on_dict(X[i, :]))
-
-        return np.array(pred)
+        return self._leaf_entries(X, 'proba')
 
     def pred_proba_on_dict(self, instance, tree=None):
         node = tree if tree is not None else self.tree_
@@ -390,22 +619,26 @@ class DL85Predictor(BaseEstimator):
         names = [x[0] for x in node.items()]
         return 'error' in names
 
-    def add_transactions_and_proba(self, X, y=None):  # explore the decision tree found and add transactions to leaf nodes.
+    def add_transactions_and_proba(self, X, y=None, sample_weight=None):  # explore the decision tree found and add transactions to leaf nodes.
+        """Adds to each node of tree_ the examples of X reaching it and, when y is given, the probability of each class
+        of classes_ among them. As for the probabilities computed by fit, the frequencies of the classes are weighted
+        by sample_weight when it is given."""
+        if y is not None and np.ndim(y) == 2 and np.shape(y)[1] > 1:
+            raise NotImplementedError("The probabilities cannot be computed for several targets")
+
+        def proba(transactions):
+            if y is None:
+                return None
+            weights = np.ones(len(transactions)) if sample_weight is None else np.asarray(sample_weight)[transactions]
+            labels = np.asarray(y)[transactions]
+            total = weights.sum()
+            return [weights[labels == c].sum() / total if total > 0 else 0 for c in self.classes_]
+
         def recurse(transactions, node, feature, positive):
             if transactions is None:
                 current_transactions = list(range(0, X.shape[0]))
                 node['transactions'] = current_transactions
-                if y is not None:
-                    unique, counts = np.unique(y[node['transactions']], return_counts=True)
-                    count_dict = dict(zip(unique, counts))
-                    node['proba'] = []
-                    for c in self.classes_:
-                        if c in count_dict:
-                            node['proba'].append(count_dict[c] / sum(counts))
-                        else:
-                            node['proba'].append(0)
-                else:
-                    node['proba'] = None
+                node['proba'] = proba(node['transactions'])
                 if 'feat' in node.keys():
                     recurse(current_transactions, node['left'], node['feat'], True)
                     recurse(current_transactions, node['right'], node['feat'], False)
@@ -417,17 +650,7 @@ class DL85Predictor(BaseEstimator):
                     positive_vector = positive_vector.tolist()
                     current_transactions = set(transactions).intersection(positive_vector)
                     node['transactions'] = list(current_transactions)
-                    if y is not None:
-                        unique, counts = np.unique(y[node['transactions']], return_counts=True)
-                        count_dict = dict(zip(unique, counts))
-                        node['proba'] = []
-                        for c in self.classes_:
-                            if c in count_dict:
-                                node['proba'].append(count_dict[c] / sum(counts))
-                            else:
-                                node['proba'].append(0)
-                    else:
-                        node['proba'] = None
+                    node['proba'] = proba(node['transactions'])
                     if 'feat' in node.keys():
                         recurse(current_transactions, node['left'], node['feat'], True)
                         recurse(current_transactions, node['right'], node['feat'], False)
@@ -436,17 +659,7 @@ class DL85Predictor(BaseEstimator):
                     negative_vector = negative_vector.tolist()
                     current_transactions = set(transactions).intersection(negative_vector)
                     node['transactions'] = list(current_transactions)
-                    if y is not None:
-                        unique, counts = np.unique(y[node['transactions']], return_counts=True)
-                        count_dict = dict(zip(unique, counts))
-                        node['proba'] = []
-                        for c in self.classes_:
-                            if c in count_dict:
-                                node['proba'].append(count_dict[c] / sum(counts))
-                            else:
-                                node['proba'].append(0)
-                    else:
-                        node['proba'] = None
+                    node['proba'] = proba(node['transactions'])
                     if 'feat' in node.keys():
                         recurse(current_transactions, node['left'], node['feat'], True)
                         recurse(current_transactions, node['right'], node['feat'], False)
@@ -454,6 +667,31 @@ class DL85Predictor(BaseEstimator):
         root_node = self.tree_
         recurse(None, root_node, None, None)
 
+    def _add_transactions_from_leaves(self, leaves):
+        """Adds to the nodes of tree_ the examples reaching them (see add_transactions_and_proba) from the preorder
+        index of the leaf reached by each example. The nodes of a subtree have consecutive indexes in preorder, so the
+        examples of a node are a slice of the examples sorted by leaf."""
+        feature, left, right, nodes = self._flat_tree()
+        leaves = np.asarray(leaves)
+        order = np.argsort(leaves, kind='stable')
+        bounds = np.searchsorted(leaves[order], np.arange(len(nodes) + 1))
+        end = list(range(1, len(nodes) + 1))  # the index following the last node of each subtree
+        for i in reversed(range(len(nodes))):
+            if feature[i] >= 0:
+                end[i] = end[right[i]]
+            nodes[i]['transactions'] = order[bounds[i]:bounds[end[i]]].tolist()
+
+    def _add_proba(self, supports=None):
+        """Adds to the nodes of tree_ the probability of each class of classes_, from the (weighted) supports of the
+        classes of each node in preorder as computed by the search. The probabilities are None without supports."""
+        feature, left, right, nodes = self._flat_tree()
+        for i, node in enumerate(nodes):
+            if supports is None:
+                node['proba'] = None
+            else:
+                total = supports[i].sum()
+                node['proba'] = (supports[i] / total).tolist() if total > 0 else [0] * len(self.classes_)
+
     def tree_without_transactions(self):
 
         def recurse(node):
@@ -1,2 +1,4 @@
 from .classifier import DL85Classifier
 from .boosting import DL85Booster
+from .forest import DL85ForestClassifier
+from .validation import cross_val_score
@@ -40,7 +40,7 @@ class DL85Booster(BaseEstimator, ClassifierMixin):
     error_function : function, default=None
         User-specific error function based on transactions
     fast_error_function : function, default=None
-        User-specific error function based on supports per class
+        User-specific error function based on supports per class. Its argument is a numpy array reused and overwritten from one call to the next: copy it to keep it after the call
     opti_gap : float, default=0.01
         This value is a tolerance to stop the column generation before optimality. It fixes the convergence problem of column generation approaches
     max_error : int, default=0
@@ -148,6 +148,7 @@ class DL85Booster(BaseEstimator, ClassifierMixin):
         self.margins_ = []  # the ensemble margin on training instances
         self.margins_norm_ = []  # the normalized margins
         self.classes_ = []
+        self._ensemble = None  # the flattened trees scored by the native scorer (see _flatten_ensemble)
         self.objective_ = None  # the optimal value reached by the ensemble
 
     def fit(self, X, y=None, X_test=None, y_test=None, iter_file=None):
@@ -325,6 +326,7 @@ class DL85Booster(BaseEstimator, ClassifierMixin):
 
         # save the number of found estimators
         self.n_estimators_ = len(self.estimators_)
+        self._flatten_ensemble()
 
         # Show each non-zero estimator weight and its tree expression if it has
         if not self.quiet:
@@ -421,20 +423,57 @@ class DL85Booster(BaseEstimator, ClassifierMixin):
             print(self.estimators_)
             print(self.estimator_weights_)
             raise NotFittedError("Call fit method first or change the regulator" % {'name': type(self).__name__})
+        # the trees of DL8.5 are scored together in C++. The class with the max weighted votes is returned
+        if self._ensemble is not None:
+            return self.classes_[np.argmax(self._votes(X), axis=1)]
         # Run a prediction on each estimator
         predict_per_clf = np.asarray([clf.predict(X) for clf in self.estimators_]).transpose()
         # return the prediction based on all estimators. The mex weighted class is returned
         return np.apply_along_axis(lambda x: np.argmax(np.bincount(x, weights=self.estimator_weights_)), axis=1, arr=predict_per_clf.astype('int'))
 
     def predict_proba(self, X):
-        classes = self.classes_[:, np.newaxis]
-        pred = sum((np.array(estimator.predict(X)) == classes).T * w for estimator, w in zip(self.estimators_, self.estimator_weights_))
+        if self._ensemble is not None:
+            pred = self._votes(X)
+        else:
+            classes = self.classes_[:, np.newaxis]
+            pred = sum((np.array(estimator.predict(X)) == classes).T * w for estimator, w in zip(self.estimators_, self.estimator_weights_))
         pred /= sum(self.estimator_weights_)
         pred[:, 0] *= -1
         decision = pred.sum(axis=1)
         decision = np.vstack([-decision, decision]).T / 2
         return self.softmax(decision, False)
 
+    def _native_ensemble(self):
+        """Whether all the estimators are trees of DL8.5, which the native ensemble scorer can evaluate."""
+        return all(hasattr(clf, "_flat_tree") and isinstance(getattr(clf, "tree_", None), dict) for clf in self.estimators_)
+
+    def _flatten_ensemble(self):
+        """Flattens the trees of the ensemble one after the other into the same arrays, so that they are evaluated
+        together on the bit-packed columns of the examples by the native scorer. The arrays are built once, at the end
+        of fit, and stored in _ensemble, which is None when some estimators are not trees of DL8.5."""
+        self._ensemble = None
+        if not self._native_ensemble():
+            return
+        class_index = {c: i for i, c in enumerate(self.classes_)}
+        feature, left, right, roots, leaf_class = [], [], [], [], []
+        for clf in self.estimators_:
+            tree_feature, tree_left, tree_right, nodes = clf._flat_tree()
+            offset = len(feature)
+            roots.append(offset)
+            feature += tree_feature
+            left += [child + offset if child >= 0 else -1 for child in tree_left]
+            right += [child + offset if child >= 0 else -1 for child in tree_right]
+            leaf_class += [0 if "feat" in node else class_index.get(node["value"], -1) for node in nodes]
+        self._ensemble = tuple(np.asarray(array, dtype=np.int32) for array in (feature, left, right, roots, leaf_class))
+
+    def _votes(self, X):
+        """Returns the sum of the weights of the estimators predicting each class (columns) for each example of X
+        (rows), scored by the native scorer on the trees flattened by _flatten_ensemble."""
+        import dl85Optimizer
+        feature, left, right, roots, leaf_class = self._ensemble
+        return dl85Optimizer.predict_votes(np.asarray(X), feature, left, right, roots, leaf_class,
+                                           self.estimator_weights_, len(self.classes_))
+
     def get_nodes_count(self):
         if self.n_estimators_ == 0:  # fit method has not been called
             raise NotFittedError("Call fit method first" % {'name': type(self).__name__})
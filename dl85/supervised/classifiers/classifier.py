@@ -1,5 +1,8 @@
 from sklearn.base import ClassifierMixin
+from sklearn.utils.validation import check_X_y
+from sklearn.utils.multiclass import unique_labels
 from ...predictors.predictor import DL85Predictor
+from ...errors.errors import TreeNotFoundError
 import json
 
 
@@ -16,7 +19,7 @@ class DL85Classifier(DL85Predictor, ClassifierMixin):
     error_function : function, default=None
         User-specific error function based on transactions
     fast_error_function : function, default=None
-        User-specific error function based on supports per class
+        User-specific error function based on supports per class. Its argument is a numpy array reused and overwritten from one call to the next: copy it to keep it after the call
     max_error : int, default=0
         Maximum allowed error. Default value stands for no bound. If no tree can be found that is strictly better, the model remains empty.
     stop_after_better : bool, default=False
@@ -33,6 +36,18 @@ class DL85Classifier(DL85Predictor, ClassifierMixin):
         A parameter used to indicate whether the sorting of items is done at each level of the lattice or only before the search
     print_output : bool, default=False
         A parameter used to indicate if the search output will be printed or not
+    error_plugin : str, default=None
+        Path of a shared object implementing the error function in C++. See the user guide for the expected symbols
+    batch_error : bool, default=False
+        Whether error_function and fast_error_function are called once per batch of sibling nodes instead of once per node
+    error_cache_size : int, default=0
+        Maximum number of results of error_function and fast_error_function memorized by cover, so that a cover reached through several paths is evaluated once. 0 disables the memorization
+    cost_matrix : array-like, shape (n_classes, n_classes), default=None
+        Cost of predicting the class of the column for an example of the class of the row. When it is provided, the total cost is minimized instead of the number of misclassified examples, at the same speed. The costs must be positive or zero
+    error_decrease_bound : float, default=None
+        Highest decrease of the value of error_function or fast_error_function on a set of examples when one example of unit weight is removed from it. When it is provided, the similarity lower bound prunes the search with these functions. A wrong value may lead to a suboptimal tree
+    target_weights : array-like, shape (n_targets,), default=None
+        Weight of the misclassification error of each target when y has several columns. A single tree predicting all the targets is then learnt with one search; the error functions are not used. Default value stands for unit weights
 
     Attributes
     ----------
@@ -50,6 +65,12 @@ class DL85Classifier(DL85Predictor, ClassifierMixin):
         The number of nodes explored before found the optimal tree
     runtime_ : float
         Time of the optimal decision tree search
+    search_stats_ : dict
+        Where the time of the search went and how many nodes each rule pruned: the times in seconds spent computing
+        the candidate attributes, intersecting covers, counting and selecting the trees of depth 2, inserting in the
+        cache, computing bounds and calling the python error functions, and the counts of trees of depth 2, cache hits
+        and nodes pruned as infeasible, as reaching their lower bound, by canSkip and by the minimum support. The times
+        of the intersections, cache inserts and bounds are 0 unless the library is built with DL85_STATS_TIMERS
     timeout_ : bool
         Whether the search reached timeout or not
     classes_ : ndarray, shape (n_classes,)
@@ -70,7 +91,13 @@ class DL85Classifier(DL85Predictor, ClassifierMixin):
             asc=False,
             repeat_sort=False,
             quiet=True,
-            print_output=False):
+            print_output=False,
+            error_plugin=None,
+            batch_error=False,
+            error_cache_size=0,
+            cost_matrix=None,
+            error_decrease_bound=None,
+            target_weights=None):
 
         DL85Predictor.__init__(self,
                                max_depth=max_depth,
@@ -86,11 +113,61 @@ class DL85Classifier(DL85Predictor, ClassifierMixin):
                                repeat_sort=repeat_sort,
                                leaf_value_function=None,
                                quiet=quiet,
-                               print_output=print_output)
+                               print_output=print_output,
+                               error_plugin=error_plugin,
+                               batch_error=batch_error,
+                               error_cache_size=error_cache_size,
+                               cost_matrix=cost_matrix,
+                               error_decrease_bound=error_decrease_bound,
+                               target_weights=target_weights)
 
     def fit(self, X, y=None, sample_weight=None):
+        # the examples of the previous calls to partial_fit are forgotten
+        self._incremental = None
         if sample_weight is None:
             return DL85Predictor.fit(self, X, y)
         else:
             self.sample_weight = sample_weight
             return DL85Predictor.fit(self, X, y)
+
+    def partial_fit(self, X, y, classes=None):
+        """Learns the tree of the examples of X and y, added to the examples of the previous calls. The examples are
+        appended to the data packed in C++. The search is not incremental: it visits every node again, but starts from
+        the bounds and from the tree of the previous call, so that the nodes whose bound is reached are closed as soon as
+        they are visited. Only the misclassification error is minimized: the error functions, the sample weights and the
+        cost matrix are not used.
+
+        Parameters
+        ----------
+        X : array-like, shape (n_samples, n_features)
+            The new training input samples.
+        y : array-like, shape (n_samples,)
+            The target values of the new samples. An array of int.
+        classes : array-like, shape (n_classes,), default=None
+            All the classes of the examples. It is only read at the first call and is needed when some classes are
+            missing from its examples.
+
+        Returns
+        -------
+        self : object
+            Returns self.
+        """
+        import dl85Optimizer
+        X, y = check_X_y(X, y, dtype='int32')
+        if getattr(self, '_incremental', None) is None:
+            self.classes_ = unique_labels(y if classes is None else classes)
+            self._incremental = dl85Optimizer.IncrementalSolver(X.shape[1], int(max(self.classes_)) + 1,
+                                                                self.max_depth, self.min_sup, self.time_limit)
+        self._incremental.add(X, y)
+        solution, tree_arrays = self._incremental.solve()
+        solution = solution.rstrip("\n").splitlines()
+        if len(solution) != 9:
+            raise TreeNotFoundError("partial_fit(): ", "Tree not found during training by DL8.5")
+        self.tree_ = self._tree_from_arrays(tree_arrays)
+        self._read_solution(solution)
+        self.search_stats_ = tree_arrays["stats"]
+        self.accuracy_ = float(solution[5].split(" ")[1])
+        self.sklearn_arrays_ = self._sklearn_arrays(tree_arrays, self.classes_)
+        self._add_proba(self.sklearn_arrays_["value"][:, 0, :])
+        self.is_fitted_ = True
+        return self
@@ -0,0 +1,126 @@
+import numpy as np
+
+from sklearn.base import BaseEstimator, ClassifierMixin
+from sklearn.exceptions import NotFittedError
+from sklearn.utils import check_random_state
+from sklearn.utils.validation import check_X_y, check_array
+
+from ...errors.errors import TreeNotFoundError
+
+
+class DL85ForestClassifier(BaseEstimator, ClassifierMixin):
+    """
+    A bagging ensemble (or random forest) of optimal binary decision trees. The dataset is loaded once in C++ and
+    shared by the searches of the trees, which run in parallel. The sample of each tree is given by the multiplicity
+    of each example in it, so the bootstrap samples are not copied.
+
+    Parameters
+    ----------
+    n_estimators : int, default=10
+        The number of trees of the ensemble
+    max_depth : int, default=1
+        Maximum depth of the trees
+    min_sup : int, default=1
+        Minimum number of examples per leaf. The examples of a bootstrap sample are counted once, whatever their
+        multiplicity, as the examples of non-zero weight of DL85Classifier
+    max_features : int, float, str or None, default=None
+        The number of features tested by each tree, drawn at random: an int, a fraction of the features (float),
+        "sqrt" or "log2". Default value stands for all the features (bagging)
+    bootstrap : bool, default=True
+        Whether each tree is learnt on a bootstrap sample of the examples or on all of them
+    time_limit : int, default=0
+        Allocated time in second(s) for the search of each tree. Default value stands for no limit
+    use_threads : bool, default=True
+        Whether the trees are learnt and evaluated in parallel
+    random_state : int, RandomState instance or None, default=None
+        The seed of the bootstrap samples and of the drawn features
+
+    Attributes
+    ----------
+    trees_ : dict
+        The trees stored one after the other in flat arrays with global node indexes ("feature", "left", "right",
+        "value" and "error"), and the index of the root of each tree ("roots")
+    errors_ : ndarray, shape (n_estimators_,)
+        The training error of each tree found on its sample
+    n_estimators_ : int
+        The number of trees found. The trees of empty samples are dropped
+    classes_ : ndarray, shape (n_classes,)
+        The classes seen at :meth:`fit`.
+    """
+
+    def __init__(
+            self,
+            n_estimators=10,
+            max_depth=1,
+            min_sup=1,
+            max_features=None,
+            bootstrap=True,
+            time_limit=0,
+            use_threads=True,
+            random_state=None):
+        self.n_estimators = n_estimators
+        self.max_depth = max_depth
+        self.min_sup = min_sup
+        self.max_features = max_features
+        self.bootstrap = bootstrap
+        self.time_limit = time_limit
+        self.use_threads = use_threads
+        self.random_state = random_state
+
+    def fit(self, X, y):
+        import dl85Optimizer
+        X, y = check_X_y(X, y, dtype='int32')
+        self.classes_, target = np.unique(y, return_inverse=True)
+        n_examples, n_features = X.shape
+        random_state = check_random_state(self.random_state)
+
+        weights = None
+        if self.bootstrap:
+            weights = np.array([np.bincount(random_state.randint(0, n_examples, n_examples), minlength=n_examples)
+                                for _ in range(self.n_estimators)], dtype=np.float32)
+
+        arrays = dl85Optimizer.solve_forest(X, target, self.n_estimators, sample_weights=weights,
+                                            max_features=self._n_tree_features(n_features),
+                                            seed=random_state.randint(np.iinfo(np.int32).max), max_depth=self.max_depth,
+                                            min_sup=self.min_sup, time_limit=self.time_limit,
+                                            use_threads=self.use_threads)
+        found = arrays["roots"] >= 0
+        if not found.any():
+            raise TreeNotFoundError("fit(): ", "No tree found by DL8.5 - all the samples of the forest are empty")
+        self.trees_ = {key: arrays[key] for key in ("feature", "left", "right", "value", "error")}
+        self.trees_["roots"] = arrays["roots"][found]
+        self.errors_ = arrays["errors"][found]
+        self.n_estimators_ = int(found.sum())
+        return self
+
+    def _n_tree_features(self, n_features):
+        """Returns the number of features tested by each tree, 0 standing for all of them."""
+        if self.max_features is None:
+            return 0
+        if self.max_features == "sqrt":
+            n = int(np.sqrt(n_features))
+        elif self.max_features == "log2":
+            n = int(np.log2(n_features))
+        elif isinstance(self.max_features, float):
+            n = int(self.max_features * n_features)
+        else:
+            n = int(self.max_features)
+        return min(max(n, 1), n_features)
+
+    def _votes(self, X):
+        """Returns the number of trees predicting each class (columns) for each example of X (rows)."""
+        import dl85Optimizer
+        if not hasattr(self, "trees_"):
+            raise NotFittedError("Call fit method first" % {'name': type(self).__name__})
+        X = check_array(X, dtype='int32')
+        trees = self.trees_
+        leaf_class = np.where(trees["feature"] < 0, trees["value"].ravel(), 0).astype(np.int32)
+        return dl85Optimizer.predict_votes(X, trees["feature"], trees["left"], trees["right"], trees["roots"],
+                                           leaf_class, np.ones(self.n_estimators_), len(self.classes_),
+                                           use_threads=self.use_threads)
+
+    def predict(self, X):
+        return self.classes_[np.argmax(self._votes(X), axis=1)]
+
+    def predict_proba(self, X):
+        return self._votes(X) / self.n_estimators_
@@ -101,3 +101,502 @@ def test_depth_4():
 
 
 check_estimator(DL85Classifier())
+
+
+def compile_shared(tmp_path, name, source):
+    """Compiles a C++ source as a shared object in tmp_path and returns its path. The test is skipped without a C++
+    compiler."""
+    import shutil
+    import subprocess
+    import sysconfig
+    import pytest
+    compiler = (sysconfig.get_config_var("CXX") or "c++").split()[0]
+    if shutil.which(compiler) is None:
+        compiler = shutil.which("c++") or shutil.which("g++") or shutil.which("clang++")
+        if compiler is None:
+            pytest.skip("no C++ compiler")
+    (tmp_path / (name + ".cpp")).write_text(source)
+    library = tmp_path / (name + ".so")
+    subprocess.check_call([compiler, "-std=c++11", "-shared", "-fPIC", "-O2", str(tmp_path / (name + ".cpp")),
+                           "-o", str(library)])
+    return str(library)
+
+
+def test_error_plugin(tmp_path):
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    # the misclassification error from the supports per class, additive
+    supports_plugin = compile_shared(tmp_path, "supports_error", """
+        extern "C" void dl85_leaf_error_from_supports(const float *supports, int nclasses, float *out) {
+            float sum = 0, max = supports[0]; int maxclass = 0;
+            for (int i = 0; i < nclasses; ++i) {
+                sum += supports[i];
+                if (supports[i] > max) { max = supports[i]; maxclass = i; }
+            }
+            out[0] = sum - max;
+            out[1] = maxclass;
+        }
+        extern "C" int dl85_error_is_additive() { return 1; }
+    """)
+    # the same error from the transactions, with the labels compiled in. It is not additive
+    tids_plugin = compile_shared(tmp_path, "tids_error", """
+        static const int labels[] = {%s};
+        extern "C" void dl85_leaf_error(const int *tids, int ntids, float *out) {
+            int count[2] = {0, 0};
+            for (int i = 0; i < ntids; ++i) ++count[labels[tids[i]]];
+            out[0] = (count[0] < count[1]) ? count[0] : count[1];
+            out[1] = (count[1] > count[0]) ? 1 : 0;
+        }
+    """ % ",".join(map(str, y)))
+    reference = DL85Classifier(max_depth=2).fit(X, y)
+    for plugin in (supports_plugin, tids_plugin):
+        clf = DL85Classifier(max_depth=2, error_plugin=plugin).fit(X, y)
+        assert clf.error_ == reference.error_ == 137
+        assert np.sum(np.asarray(clf.predict(X)) != y) == 137
+
+
+def test_batch_error():
+    import pytest
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+
+    def error(tids):
+        supports = np.bincount(y[list(tids)], minlength=2)
+        return [supports.sum() - supports.max(), supports.argmax()]
+
+    def batch_error(indptr, tids):
+        supports = np.array([np.bincount(y[tids[indptr[i]:indptr[i + 1]]], minlength=2) for i in range(len(indptr) - 1)])
+        return supports.sum(axis=1) - supports.max(axis=1), supports.argmax(axis=1)
+
+    def fast_error(supports):
+        return supports.sum() - supports.max(), supports.argmax()
+
+    def batch_fast_error(supports):
+        return supports.sum(axis=1) - supports.max(axis=1), supports.argmax(axis=1)
+
+    # the batches give the errors of the calls per node, so the same tree is found
+    for per_node, batch, kind in ((error, batch_error, "error_function"), (fast_error, batch_fast_error, "fast_error_function")):
+        single = DL85Classifier(max_depth=2, **{kind: per_node}).fit(X, y)
+        batched = DL85Classifier(max_depth=2, batch_error=True, **{kind: batch}).fit(X, y)
+        assert single.error_ == batched.error_ == 137
+        assert single._flat_tree()[0] == batched._flat_tree()[0]
+
+    def failing_error(indptr, tids):
+        raise ValueError("failure")
+
+    with pytest.raises(RuntimeError):
+        DL85Classifier(max_depth=2, error_function=failing_error, batch_error=True).fit(X, y)
+
+
+def test_fast_error_buffer():
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    arguments, copies = [], []
+
+    def error(supports):
+        arguments.append(supports)
+        copies.append(np.array(supports))
+        return supports.sum() - supports.max(), supports.argmax()
+
+    clf = DL85Classifier(max_depth=2, fast_error_function=error)
+    clf.fit(X, y)
+    assert clf.error_ == 137
+    # the same array is overwritten at each call, so only the copies keep the supports of each node
+    assert all(argument is arguments[0] for argument in arguments)
+    assert any(not np.array_equal(copy, copies[-1]) for copy in copies)
+    assert np.array_equal(arguments[0], copies[-1])
+
+
+def test_error_cache():
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    for kind in ("error_function", "fast_error_function"):
+        calls = [0]
+
+        def error(values):
+            calls[0] += 1
+            supports = values if kind == "fast_error_function" else np.bincount(y[list(values)], minlength=2)
+            return supports.sum() - supports.max(), supports.argmax()
+
+        uncached = DL85Classifier(max_depth=2, **{kind: error}).fit(X, y)
+        uncached_calls, calls[0] = calls[0], 0
+        cached = DL85Classifier(max_depth=2, error_cache_size=100000, **{kind: error}).fit(X, y)
+        # the covers reached through several itemsets are evaluated once
+        assert cached.error_ == uncached.error_ == 137
+        assert cached._flat_tree()[0] == uncached._flat_tree()[0]
+        assert calls[0] < uncached_calls
+
+
+def test_cost_matrix():
+    import pytest
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    clf = DL85Classifier(max_depth=2, cost_matrix=[[0, 1], [1, 0]])
+    clf.fit(X, y)
+    assert clf.error_ == 137
+
+    clf = DL85Classifier(max_depth=2, cost_matrix=[[0, 5], [1, 0]])
+    clf.fit(X, y)
+    y_pred = np.asarray(clf.predict(X))
+    assert abs(clf.error_ - (5 * np.sum((y == 0) & (y_pred == 1)) + np.sum((y == 1) & (y_pred == 0)))) < 1e-3
+
+    # the lower bounds are wrong with negative costs
+    for costs in ([[0, -1], [1, 0]], [[0, np.nan], [1, 0]]):
+        with pytest.raises(ValueError):
+            DL85Classifier(max_depth=2, cost_matrix=costs).fit(X, y)
+
+
+def test_error_decrease_bound():
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+
+    def error(supports):
+        return supports.sum() - supports.max(), supports.argmax()
+
+    clf = DL85Classifier(max_depth=2, fast_error_function=error, error_decrease_bound=1)
+    clf.fit(X, y)
+    assert clf.error_ == 137
+
+
+def test_multi_target():
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    clf = DL85Classifier(max_depth=2, target_weights=[1, 2])
+    clf.fit(X, np.column_stack((y, y)))
+    assert clf.error_ == 3 * 137
+    y_pred = np.asarray(clf.predict(X))
+    assert y_pred.shape == (X.shape[0], 2)
+    assert np.array_equal(y_pred[:, 0], y_pred[:, 1])
+
+    # only the misclassification of the targets is minimized, and the leaves have no probabilities
+    import pytest
+    with pytest.raises(NotImplementedError):
+        clf.predict_proba(X)
+    with pytest.raises(NotImplementedError):
+        clf.add_transactions_and_proba(X, np.column_stack((y, y)))
+    with pytest.raises(ValueError):
+        DL85Classifier(max_depth=2, fast_error_function=lambda s: (s.sum() - s.max(), s.argmax())).fit(
+            X, np.column_stack((y, y)))
+
+
+def test_flat_tree():
+    import dl85Optimizer
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    solution, arrays = dl85Optimizer.solve(data=X, target=y, max_depth=2, flat_tree=True)
+    leaves = arrays["feature"] < 0
+    assert abs(arrays["error"][0] - 137) < 1e-3
+    assert abs(arrays["error"][leaves].sum() - 137) < 1e-3
+    assert np.all(arrays["left"][~leaves] > np.flatnonzero(~leaves))
+
+    clf = DL85Classifier(max_depth=2)
+    clf.fit(X, y)
+    assert clf.tree_["feat"] == arrays["feature"][0]
+    assert clf.get_nodes_count() == len(arrays["feature"])
+
+
+def test_native_predict():
+    import dl85Optimizer
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    X = np.tile(X, (7, 1))[:5000]  # several blocks of rows
+    clf = DL85Classifier(max_depth=3)
+    clf.fit(dataset[:, 1:], y)
+    expected = [clf.pred_value_on_dict(x) for x in X]
+    assert np.array_equal(clf.predict(X), expected)
+    assert np.array_equal(clf.predict_proba(X), [clf.pred_proba_on_dict(x) for x in X])
+
+    feature, left, right, nodes = clf._flat_tree()
+    leaves = dl85Optimizer.predict_leaves(X, feature, left, right, use_threads=False)
+    assert all(nodes[leaf]["value"] == value for leaf, value in zip(leaves, expected))
+
+
+def test_ensemble_votes():
+    import pytest
+    pytest.importorskip("cvxpy")
+    from ..boosting import DL85Booster
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    y = np.where(y == 1, 7, 3)  # the labels are not the indexes of the classes
+    # the ensemble is built without the column generation, which needs an LP solver
+    booster = DL85Booster()
+    weights = np.linspace(1, 2, len(y))
+    booster.estimators_ = [DL85Classifier(max_depth=depth).fit(X, y, sample_weight=list(weights[::step]))
+                           for depth, step in ((1, 1), (2, -1), (3, 1))]
+    booster.estimator_weights_ = np.array([0.4, 0.35, 0.5])
+    booster.n_estimators_ = len(booster.estimators_)
+    booster.classes_ = np.array([3, 7])
+    # as at the end of fit, the trees are flattened once for all the predictions
+    booster._flatten_ensemble()
+    assert booster._ensemble is not None
+
+    # the votes of the trees scored in python, as before the native scorer
+    predict_per_clf = np.asarray([clf.predict(X) for clf in booster.estimators_]).transpose()
+    expected = np.apply_along_axis(lambda x: np.argmax(np.bincount(x, weights=booster.estimator_weights_)), axis=1,
+                                   arr=predict_per_clf.astype('int'))
+    pred = sum((np.array(clf.predict(X)) == booster.classes_[:, np.newaxis]).T * w
+               for clf, w in zip(booster.estimators_, booster.estimator_weights_))
+    pred /= sum(booster.estimator_weights_)
+    pred[:, 0] *= -1
+    decision = pred.sum(axis=1)
+    expected_proba = booster.softmax(np.vstack([-decision, decision]).T / 2, False)
+
+    assert np.array_equal(booster.predict(X), expected)
+    assert set(np.unique(expected)) <= {3, 7}
+    assert np.allclose(booster.predict_proba(X), expected_proba)
+
+
+def test_native_leaf_assignment():
+    import dl85Optimizer
+    from copy import deepcopy
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    solution, arrays = dl85Optimizer.solve(data=X, target=y, max_depth=3, flat_tree=True)
+    assert np.array_equal(arrays["transaction_leaf"],
+                          dl85Optimizer.predict_leaves(X, arrays["feature"], arrays["left"], arrays["right"]))
+
+    clf = DL85Classifier(max_depth=3)
+    clf.fit(X, y)
+    native = deepcopy(clf.tree_)
+    clf.add_transactions_and_proba(X, y)
+
+    def compare(node, expected):
+        assert np.allclose(node['proba'], expected['proba'])
+        if 'feat' in node:
+            compare(node['left'], expected['left'])
+            compare(node['right'], expected['right'])
+
+    compare(native, clf.tree_)
+
+    # the probabilities of both passes are weighted frequencies of the classes
+    weights = 1 + np.arange(X.shape[0]) % 3
+    clf.fit(X, y, sample_weight=weights.tolist())
+    native = deepcopy(clf.tree_)
+    clf.add_transactions_and_proba(X, y, sample_weight=weights)
+    compare(native, clf.tree_)
+
+
+def test_complete_tree_export():
+    import dl85Optimizer
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    clf = DL85Classifier(max_depth=3, min_sup=30)
+    clf.fit(X, y)
+    complete = dl85Optimizer.complete_tree(*clf._flat_tree_values())
+    node = np.zeros(X.shape[0], dtype=int)
+    for _ in range(complete["depth"]):
+        node = 2 * node + 2 - (X[np.arange(X.shape[0]), complete["feature"][node]] != 0)
+    leaf_values = complete["value"][node - (2 ** complete["depth"] - 1), 0]
+    assert np.array_equal(leaf_values, clf.predict(X))
+
+
+def test_export_cpp(tmp_path):
+    import ctypes
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    clf = DL85Classifier(max_depth=3, min_sup=30)
+    clf.fit(X, y)
+    rows = np.ascontiguousarray(X, dtype=np.int32)  # one example after the other, as expected by the exported function
+    for conditional in (False, True):
+        name = "anneal_conditional" if conditional else "anneal_complete"
+        header = clf.export_cpp(name, conditional)
+        assert "inline const float *%s(const int *x)" % name in header
+        (tmp_path / (name + ".h")).write_text(header)
+        library = ctypes.CDLL(compile_shared(tmp_path, name, """
+            #include "%s.h"
+            extern "C" void predict(const int *rows, int nrows, int nfeatures, float *out) {
+                for (int i = 0; i < nrows; ++i) out[i] = %s(rows + (long) i * nfeatures)[0];
+            }
+        """ % (name, name)))
+        predictions = np.zeros(X.shape[0], dtype=np.float32)
+        library.predict(rows.ctypes.data_as(ctypes.POINTER(ctypes.c_int)), ctypes.c_int(X.shape[0]),
+                        ctypes.c_int(X.shape[1]), predictions.ctypes.data_as(ctypes.POINTER(ctypes.c_float)))
+        assert np.array_equal(predictions, clf.predict(X))
+
+
+def test_sklearn_arrays():
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    clf = DL85Classifier(max_depth=3)
+    clf.fit(X, y)
+    tree = clf.sklearn_arrays_
+    assert tree["n_node_samples"][0] == X.shape[0]
+    assert np.allclose(tree["value"][0, 0], np.bincount(y))
+
+    node = np.zeros(X.shape[0], dtype=int)
+    while np.any(tree["children_left"][node] >= 0):
+        internal = tree["children_left"][node] >= 0
+        goes_left = X[np.arange(X.shape[0]), tree["feature"][node]] <= tree["threshold"][node]
+        node = np.where(internal, np.where(goes_left, tree["children_left"][node], tree["children_right"][node]), node)
+    assert np.array_equal(clf.classes_[np.argmax(tree["value"][node, 0], axis=1)], clf.predict(X))
+    assert np.array_equal(np.bincount(node, minlength=tree["node_count"])[tree["children_left"] < 0],
+                          tree["n_node_samples"][tree["children_left"] < 0])
+    root_frequencies = np.bincount(y) / len(y)
+    assert abs(tree["impurity"][0] - (1 - np.sum(root_frequencies ** 2))) < 1e-6
+
+    # the arrays are loaded in a tree of scikit-learn, which predicts as the classifier
+    from sklearn.tree._tree import Tree
+    sklearn_tree = Tree(X.shape[1], np.array([len(clf.classes_)], dtype=np.intp), 1)
+    state = sklearn_tree.__getstate__()
+    nodes = np.zeros(tree["node_count"], dtype=state["nodes"].dtype)
+    names = {"left_child": "children_left", "right_child": "children_right"}
+    for field in ("left_child", "right_child", "feature", "threshold", "impurity", "n_node_samples",
+                  "weighted_n_node_samples"):
+        nodes[field] = tree[names.get(field, field)]
+    state.update(max_depth=clf.depth_, node_count=tree["node_count"], nodes=nodes,
+                 values=np.ascontiguousarray(tree["value"], dtype=np.float64))
+    sklearn_tree.__setstate__(state)
+    values = sklearn_tree.predict(np.ascontiguousarray(X, dtype=np.float32))
+    assert np.array_equal(clf.classes_[np.argmax(values[:, 0], axis=1)], clf.predict(X))
+
+
+def test_weighted_proba():
+    import dl85Optimizer
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    weights = 1 + np.arange(X.shape[0]) % 3
+    clf = DL85Classifier(max_depth=2)
+    clf.fit(X, y, sample_weight=weights.tolist())
+    feature, left, right, nodes = clf._flat_tree()
+    leaves = dl85Optimizer.predict_leaves(X, feature, left, right)
+    proba = np.asarray(clf.predict_proba(X))
+    # with sample weights, the probabilities of a leaf are the weighted frequencies of the classes of its examples
+    unweighted = np.zeros(proba.shape)
+    for leaf in np.unique(leaves):
+        rows = leaves == leaf
+        for c, label in enumerate(clf.classes_):
+            assert np.allclose(proba[rows, c], weights[rows & (y == label)].sum() / weights[rows].sum(), atol=1e-5)
+            unweighted[rows, c] = np.sum(rows & (y == label)) / np.sum(rows)
+    assert not np.allclose(proba, unweighted)
+
+
+def test_forest():
+    import dl85Optimizer
+    from ..forest import DL85ForestClassifier
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    # a tree learnt on all the examples with unit weights is the tree of the search
+    arrays = dl85Optimizer.solve_forest(X, y, 1, max_depth=3)
+    assert arrays["roots"][0] == 0 and arrays["errors"][0] == 112
+
+    # the examples of null weight are out of the sample of the tree
+    weights = np.ones((2, X.shape[0]), dtype=np.float32)
+    weights[1, y == 0] = 0
+    arrays = dl85Optimizer.solve_forest(X, y, 2, sample_weights=weights, max_depth=2)
+    assert arrays["errors"][1] == 0 and arrays["feature"][arrays["roots"][1]] == -1
+
+    forest = DL85ForestClassifier(n_estimators=5, max_depth=2, max_features=10, random_state=0)
+    forest.fit(X, y)
+    assert forest.n_estimators_ == 5
+    proba = forest.predict_proba(X)
+    assert np.allclose(proba.sum(axis=1), 1)
+    assert np.array_equal(forest.predict(X), forest.classes_[np.argmax(proba, axis=1)])
+
+    # each tree only tests its own draw of max_features features, while the tree of all the features tests more
+    def tree_features(forest):
+        bounds = list(forest.trees_["roots"]) + [len(forest.trees_["feature"])]
+        return [set(forest.trees_["feature"][bounds[t]:bounds[t + 1]]) - {-1} for t in range(forest.n_estimators_)]
+
+    forest = DL85ForestClassifier(n_estimators=5, max_depth=3, bootstrap=False, random_state=0).fit(X, y)
+    assert all(len(features) > 2 for features in tree_features(forest))
+    forest = DL85ForestClassifier(n_estimators=5, max_depth=3, max_features=2, bootstrap=False, random_state=0)
+    forest.fit(X, y)
+    assert all(len(features) <= 2 for features in tree_features(forest))
+    assert np.all(forest.errors_ >= 112)
+
+
+def training_accuracy(output):
+    return float(next(line for line in output.splitlines() if line.startswith("Accuracy:")).split(" ")[1])
+
+
+def test_cross_validation_masks():
+    import dl85Optimizer
+    from sklearn.model_selection import KFold
+    from ..validation import cross_val_score
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    scores = cross_val_score(X, y, n_folds=4, max_depth=2)
+    for score, (train, test) in zip(scores, KFold(4).split(X)):
+        # the search on the mask of the training examples finds the tree of the search on their copy
+        mask = np.zeros(len(y), dtype=bool)
+        mask[train] = True
+        output, masked = dl85Optimizer.solve(data=X, target=y, max_depth=2, root_mask=mask, flat_tree=True)
+        copied = dl85Optimizer.solve(data=X[train], target=y[train], max_depth=2, flat_tree=True)[1]
+        assert np.array_equal(masked["feature"], copied["feature"]) and masked["error"][0] == copied["error"][0]
+        # the training accuracy of the fold is that of its examples only, weighted as in the search
+        assert np.isclose(training_accuracy(output), 1 - masked["error"][0] / len(train), atol=1e-5)
+        weights = 1. + np.arange(len(y)) % 3
+        output, weighted = dl85Optimizer.solve(data=X, target=y, max_depth=2, root_mask=mask,
+                                               example_weights=weights.tolist(), flat_tree=True)
+        assert np.isclose(training_accuracy(output), 1 - weighted["error"][0] / weights[train].sum(), atol=1e-5)
+        clf = DL85Classifier(max_depth=2).fit(X[train], y[train])
+        assert np.isclose(score, accuracy_score(y[test], clf.predict(X[test])))
+
+
+def test_partial_fit():
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    clf = DL85Classifier(max_depth=3)
+    for end in (600, 700, len(y)):
+        start = 0 if end == 600 else end - 100 if end == 700 else 700
+        clf.partial_fit(X[start:end], y[start:end], classes=[0, 1])
+        # the incremental search finds the optimal error of all the examples added so far
+        reference = DL85Classifier(max_depth=3).fit(X[:end], y[:end])
+        assert clf.error_ == reference.error_
+        assert clf.sklearn_arrays_["n_node_samples"][0] == end
+    assert clf.error_ == 112 and np.isclose(clf.accuracy_, reference.accuracy_)
+
+
+def test_partial_fit_pickle():
+    import pickle
+    from copy import deepcopy
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    clf = DL85Classifier(max_depth=3)
+    clf.partial_fit(X[:600], y[:600], classes=[0, 1])
+    # the copy keeps the examples added so far, and the next call adds the new ones to them
+    copies = [pickle.loads(pickle.dumps(clf)), deepcopy(clf)]
+    for estimator in copies:
+        assert estimator.tree_ == clf.tree_ and estimator._incremental.n_examples == 600
+    for estimator in [clf] + copies:
+        estimator.partial_fit(X[600:], y[600:])
+        assert estimator.error_ == 112 and estimator._incremental.n_examples == len(y)
+
+
+def test_search_trace(tmp_path):
+    import dl85Optimizer
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    trace_file = tmp_path / "anneal.trace"
+    traced = dl85Optimizer.solve(data=X, target=y, max_depth=2, trace_file=trace_file, flat_tree=True)[1]
+    # recording the operations does not change the search
+    untraced = dl85Optimizer.solve(data=X, target=y, max_depth=2, flat_tree=True)[1]
+    assert np.array_equal(traced["feature"], untraced["feature"]) and traced["error"][0] == untraced["error"][0]
+    with open(trace_file, "rb") as file:
+        assert file.read(7) == b"DL85TRC"
+    assert trace_file.stat().st_size > X.size // 8
+
+
+def test_tracing_file(tmp_path):
+    import json
+    import dl85Optimizer
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    tracing_file = tmp_path / "anneal.json"
+    tree = dl85Optimizer.solve(data=X, target=y, max_depth=3, tracing_file=tracing_file, flat_tree=True)[1]
+    assert tree["error"][0] == 112
+    with open(tracing_file) as file:
+        events = json.load(file)["traceEvents"]
+    names = {event["name"] for event in events}
+    assert {"search", "recurse", "depth two counting", "node searched"} <= names
+
+
+def test_search_stats():
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0]
+    clf = DL85Classifier(max_depth=3, min_sup=5).fit(X, y)
+    stats = clf.search_stats_
+    assert stats["depth_two_calls"] > 0 and stats["depth_two_count_time"] > 0
+    assert stats["pruned_minsup"] > 0 and stats["callback_time"] == 0
+    # the phases are parts of the search
+    assert sum(value for key, value in stats.items() if key.endswith("_time")) <= clf.runtime_
@@ -0,0 +1,59 @@
+import numpy as np
+
+from sklearn.model_selection import KFold
+from sklearn.utils.validation import check_X_y
+
+
+def cross_val_score(X, y, n_folds=5, max_depth=1, min_sup=1, time_limit=0, shuffle=False, random_state=None,
+                    use_threads=True):
+    """
+    Returns the test accuracy of the optimal tree of each fold of a k-fold cross-validation. The dataset is loaded once
+    in C++: the training examples of a fold are given to its search as a mask of the root cover instead of a copy of
+    the data, and the searches of the folds run in parallel.
+
+    Parameters
+    ----------
+    X : array-like, shape (n_examples, n_features)
+        The Boolean examples
+    y : array-like, shape (n_examples,)
+        The classes of the examples
+    n_folds : int, default=5
+        The number of folds
+    max_depth : int, default=1
+        Maximum depth of the trees
+    min_sup : int, default=1
+        Minimum number of examples per leaf
+    time_limit : int, default=0
+        Allocated time in second(s) for the search of each fold. Default value stands for no limit
+    shuffle : bool, default=False
+        Whether the examples are shuffled before being split into folds, as in sklearn.model_selection.KFold
+    random_state : int, RandomState instance or None, default=None
+        The seed of the shuffle
+    use_threads : bool, default=True
+        Whether the folds are searched and evaluated in parallel
+
+    Returns
+    -------
+    scores : ndarray, shape (n_folds,)
+        The accuracy of each fold on its test examples. It is nan when no tree is found for the fold
+    """
+    import dl85Optimizer
+    X, y = check_X_y(X, y, dtype='int32')
+    classes, target = np.unique(y, return_inverse=True)
+    folds = list(KFold(n_folds, shuffle=shuffle, random_state=random_state if shuffle else None).split(X))
+    masks = np.ones((n_folds, X.shape[0]), dtype=np.int32)
+    for fold, (_, test) in enumerate(folds):
+        masks[fold, test] = 0
+
+    trees = dl85Optimizer.solve_forest(X, target, n_folds, sample_masks=masks, max_depth=max_depth, min_sup=min_sup,
+                                       time_limit=time_limit, use_threads=use_threads)
+    leaf_class = np.where(trees["feature"] < 0, trees["value"].ravel(), 0).astype(np.int32)
+    scores = np.full(n_folds, np.nan)
+    for fold, (_, test) in enumerate(folds):
+        root = trees["roots"][fold]
+        if root < 0:
+            continue
+        votes = dl85Optimizer.predict_votes(X[test], trees["feature"], trees["left"], trees["right"], [root],
+                                            leaf_class, [1.], len(classes), use_threads=use_threads)
+        scores[fold] = np.mean(np.argmax(votes, axis=1) == target[test])
+    return scores
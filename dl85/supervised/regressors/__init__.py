@@ -0,0 +1 @@
+from .regressor import DL85Regressor
@@ -0,0 +1,116 @@
+from sklearn.base import RegressorMixin
+from ...predictors.predictor import DL85Predictor
+import numpy as np
+
+
+class DL85Regressor(DL85Predictor, RegressorMixin):
+    """ An optimal binary decision tree regressor.
+
+    Parameters
+    ----------
+    max_depth : int, default=1
+        Maximum depth of the tree to be found
+    min_sup : int, default=1
+        Minimum number of examples per leaf
+    criterion : str, default="mse"
+        The error minimized by the tree. "mse" for the sum of squared errors, the leaves predicting the mean of their targets; "mae" for the sum of absolute errors, the leaves predicting the median of their targets. "mse" is much faster to optimize
+    max_error : int, default=0
+        Maximum allowed error. Default value stands for no bound. If no tree can be found that is strictly better, the model remains empty.
+    stop_after_better : bool, default=False
+        A parameter used to indicate if the search will stop after finding a tree better than max_error
+    time_limit : int, default=0
+        Allocated time in second(s) for the search. Default value stands for no limit. The best tree found within the time limit is stored, if this tree is better than max_error.
+    verbose : bool, default=False
+        A parameter used to switch on/off the print of what happens during the search
+    quiet : bool, default=True
+        A parameter used to switch off the print of the fitting messages
+    print_output : bool, default=False
+        A parameter used to indicate if the search output will be printed or not
+
+    Attributes
+    ----------
+    tree_ : str
+        Outputted tree in serialized form; remains empty as long as no model is learned.
+    size_ : int
+        The size of the outputted tree
+    depth_ : int
+        Depth of the found tree
+    error_ : float
+        Error of the found tree
+    lattice_size_ : int
+        The number of nodes explored before found the optimal tree
+    runtime_ : float
+        Time of the optimal decision tree search
+    search_stats_ : dict
+        Where the time of the search went and how many nodes each rule pruned: the times in seconds spent computing
+        the candidate attributes, intersecting covers, counting and selecting the trees of depth 2, inserting in the
+        cache, computing bounds and calling the python error functions, and the counts of trees of depth 2, cache hits
+        and nodes pruned as infeasible, as reaching their lower bound, by canSkip and by the minimum support. The times
+        of the intersections, cache inserts and bounds are 0 unless the library is built with DL85_STATS_TIMERS
+    timeout_ : bool
+        Whether the search reached timeout or not
+    """
+
+    def __init__(
+            self,
+            max_depth=1,
+            min_sup=1,
+            criterion="mse",
+            max_error=0,
+            stop_after_better=False,
+            time_limit=0,
+            verbose=False,
+            quiet=True,
+            print_output=False):
+
+        DL85Predictor.__init__(self,
+                               max_depth=max_depth,
+                               min_sup=min_sup,
+                               error_function=None,
+                               fast_error_function=None,
+                               max_error=max_error,
+                               stop_after_better=stop_after_better,
+                               time_limit=time_limit,
+                               verbose=verbose,
+                               desc=False,
+                               asc=False,
+                               repeat_sort=False,
+                               leaf_value_function=None,
+                               quiet=quiet,
+                               print_output=print_output)
+        self.criterion = criterion
+
+    def fit(self, X, y, sample_weight=None):
+        """Implements the standard fitting function for a DL8.5 regressor.
+
+        Parameters
+        ----------
+        X : array-like, shape (n_samples, n_features)
+            The training input samples. The features must be binary.
+        y : array-like, shape (n_samples,)
+            The target values. An array of float.
+        sample_weight : array-like, shape (n_samples,), default=None
+            The weight of each sample in the error.
+
+        Returns
+        -------
+        self : object
+            Returns self.
+        """
+        self.sample_weight = [] if sample_weight is None else sample_weight
+        return DL85Predictor.fit(self, X, y)
+
+    def predict(self, X):
+        """ Implements the standard predict function for a DL8.5 regressor.
+
+        Parameters
+        ----------
+        X : array-like, shape (n_samples, n_features)
+            The input samples.
+
+        Returns
+        -------
+        y : ndarray, shape (n_samples,)
+            The value of the leaf reached by each sample.
+        """
+        return np.asarray(DL85Predictor.predict(self, X), dtype=np.float64)
@@ -0,0 +1,35 @@
+from ..regressor import DL85Regressor
+import numpy as np
+
+dev = "../../../../"
+prod = ""
+prefix = prod
+# prefix = dev
+
+
+def brute_force_depth_1(X, y):
+    best = ((y - y.mean()) ** 2).sum()
+    for feat in range(X.shape[1]):
+        left, right = y[X[:, feat] == 1], y[X[:, feat] == 0]
+        if len(left) > 0 and len(right) > 0:
+            best = min(best, ((left - left.mean()) ** 2).sum() + ((right - right.mean()) ** 2).sum())
+    return best
+
+
+def test_mse():
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X = dataset[:, 1:]
+    y = 10 * dataset[:, 0] + 3 * X[:, 3] + np.random.RandomState(0).normal(size=X.shape[0])
+    reg = DL85Regressor(max_depth=1)
+    reg.fit(X, y)
+    assert abs(reg.error_ - brute_force_depth_1(X, y)) <= 1e-3 * reg.error_
+    assert abs(((reg.predict(X) - y) ** 2).sum() - reg.error_) <= 1e-3 * reg.error_
+
+
+def test_mae():
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X, y = dataset[:, 1:], dataset[:, 0].astype('float64')
+    reg = DL85Regressor(max_depth=2, criterion="mae")
+    reg.fit(X, y)
+    assert reg.depth_ <= 2
+    assert abs(np.abs(reg.predict(X) - y).sum() - reg.error_) <= 1e-3 * max(reg.error_, 1)
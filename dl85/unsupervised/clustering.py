@@ -14,6 +14,10 @@ class DL85Cluster(DL85Predictor, ClusterMixin):
         Maximum depth of the tree to be found
     min_sup : int, default=1
         Minimum number of examples per leaf
+    error_function : function, default=None
+        Function returning the error of a leaf given the list of its examples. Default value stands for the error given by criterion
+    criterion : {"euclidean", "squared_euclidean"}, default="euclidean"
+        The error of a leaf when no error_function is given: the sum of the euclidean distances of its examples to their centroid, computed in Python, or the sum of the squared euclidean distances, as k-means, computed in C++ without Python callback and much faster
     max_error : int, default=0
         Maximum allowed error. Default value stands for no bound. If no tree can be found that is strictly better, the model remains empty.
     stop_after_better : bool, default=False
@@ -47,6 +51,12 @@ class DL85Cluster(DL85Predictor, ClusterMixin):
         The number of nodes explored before found the optimal tree
     runtime_ : float
         Time of the optimal decision tree search
+    search_stats_ : dict
+        Where the time of the search went and how many nodes each rule pruned: the times in seconds spent computing
+        the candidate attributes, intersecting covers, counting and selecting the trees of depth 2, inserting in the
+        cache, computing bounds and calling the python error functions, and the counts of trees of depth 2, cache hits
+        and nodes pruned as infeasible, as reaching their lower bound, by canSkip and by the minimum support. The times
+        of the intersections, cache inserts and bounds are 0 unless the library is built with DL85_STATS_TIMERS
     timeout_ : bool
         Whether the search reached timeout or not
     classes_ : ndarray, shape (n_classes,)
@@ -66,7 +76,8 @@ class DL85Cluster(DL85Predictor, ClusterMixin):
             asc=False,
             repeat_sort=False,
             leaf_value_function=None,
-            print_output=False):
+            print_output=False,
+            criterion="euclidean"):
 
         DL85Predictor.__init__(self,
                                max_depth=max_depth,
@@ -82,6 +93,7 @@ class DL85Cluster(DL85Predictor, ClusterMixin):
                                repeat_sort=repeat_sort,
                                leaf_value_function=leaf_value_function,
                                print_output=print_output)
+        self.criterion = criterion
 
     @staticmethod
     def default_error(tids, X):
@@ -116,14 +128,21 @@ class DL85Cluster(DL85Predictor, ClusterMixin):
             assert_all_finite(X_error)
             X_error = check_array(X_error, dtype='int32')
 
-        if self.error_function is None:
-            if X_error is None:
-                self.error_function = lambda tids: self.default_error(tids, X)
+        if self.criterion not in ("euclidean", "squared_euclidean"):
+            raise ValueError("criterion must be 'euclidean' or 'squared_euclidean', not " + repr(self.criterion))
+        if X_error is not None and X_error.shape[0] != X.shape[0]:
+            raise ValueError("X_error does not have the same number of rows as X")
+        error_X = X if X_error is None else X_error
+
+        # the sum of squared distances of the examples to the centroids of their leaves is computed in C++ from the
+        # sums and the sums of squares of the features of each cover
+        self.error_target_ = None
+        fit_error_function = self.error_function
+        if fit_error_function is None:
+            if self.criterion == "squared_euclidean":
+                self.error_target_ = check_array(error_X, dtype='float32')
             else:
-                if X_error.shape[0] == X.shape[0]:
-                    self.error_function = lambda tids: self.default_error(tids, X_error)
-                else:
-                    raise ValueError("X_error does not have the same number of rows as X")
+                fit_error_function = lambda tids: self.default_error(tids, error_X)
 
         if self.leaf_value_function is None:
             if X_error is None:
@@ -134,13 +153,20 @@ class DL85Cluster(DL85Predictor, ClusterMixin):
                 else:
                     raise ValueError("X_error does not have the same number of rows as X")
 
-        # call fit method of the predictor
-        DL85Predictor.fit(self, X)
+        # call fit method of the predictor. The default error function is not kept as a parameter of the estimator
+        self.error_function, user_error_function = fit_error_function, self.error_function
+        try:
+            DL85Predictor.fit(self, X)
+        finally:
+            self.error_function = user_error_function
         # print(self.tree_)
 
         # Return the classifier
         return self
 
+    def _native_target(self, X, y):
+        return self.error_target_
+
     def predict(self, X):
         """ Implements the standard predict function for a DL8.5 classifier.
 
@@ -0,0 +1,34 @@
+from ..clustering import DL85Cluster
+import numpy as np
+
+dev = "../../../"
+prod = ""
+prefix = prod
+# prefix = dev
+
+
+def squared_distances(X):
+    def error(tids):
+        X_subset = X[list(tids)]
+        return float(((X_subset - X_subset.mean(axis=0)) ** 2).sum())
+    return error
+
+
+def test_squared_euclidean():
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X = dataset[:100, 1:11]
+    # the native error is the error of the python callback computing the same sum
+    native = DL85Cluster(max_depth=2, criterion="squared_euclidean").fit(X)
+    python = DL85Cluster(max_depth=2, error_function=squared_distances(X)).fit(X)
+    assert abs(native.error_ - python.error_) <= 1e-3 * max(python.error_, 1)
+
+
+def test_default_euclidean():
+    dataset = np.genfromtxt(prefix + "datasets/anneal.txt", delimiter=' ').astype('int32')
+    X = dataset[:100, 1:11]
+    clf = DL85Cluster(max_depth=1).fit(X)
+    assert clf.error_function is None and clf.criterion == "euclidean"
+    # the default error is the sum of the euclidean distances to the centroids of the leaves
+    default = DL85Cluster(max_depth=1, error_function=lambda tids: DL85Cluster.default_error(tids, X)).fit(X)
+    assert abs(clf.error_ - default.error_) < 1e-6
+    assert clf.error_ != DL85Cluster(max_depth=1, criterion="squared_euclidean").fit(X).error_
@@ -52,24 +52,38 @@ EXTENSION_SOURCE_FILES = ['cython_extension/error_function.pyx',
                           'core/src/dl85.cpp',
                           'core/src/globals.cpp',
                           'core/src/lcm_pruned.cpp',
+                          'core/src/leafCache.cpp',
+                          'core/src/nativeError.cpp',
                           'core/src/query.cpp',
                           'core/src/query_best.cpp',
                           'core/src/query_totalfreq.cpp',
                           'core/src/rCover.cpp',
                           'core/src/rCoverTotalFreq.cpp',
                           'core/src/rCoverWeighted.cpp',
+                          'core/src/rCoverRegression.cpp',
+                          'core/src/searchTrace.cpp',
+                          'core/src/tracing.cpp',
+                          'core/src/query_regression.cpp',
+                          'core/src/query_multitarget.cpp',
+                          'core/src/completeTree.cpp',
+                          'core/src/forest.cpp',
+                          'core/src/incrementalSearch.cpp',
+                          'core/src/treePredictor.cpp',
                           'core/src/trie.cpp', ]
 EXTENSION_INCLUDE_DIR = ['core/src', 'cython_extension']
 # EXTENSION_BUILD_ARGS = ['-std=c++11']
-EXTENSION_BUILD_ARGS = ['-std=c++11', '-DCYTHON_PEP489_MULTI_PHASE_INIT=0']
+# DL85_TRACING compiles the trace events of the search, recorded only when a tracing file is given
+EXTENSION_BUILD_ARGS = ['-std=c++11', '-DCYTHON_PEP489_MULTI_PHASE_INIT=0', '-DDL85_TRACING']
 if platform.system() == 'Darwin':
     EXTENSION_BUILD_ARGS.append('-mmacosx-version-min=10.12')
+EXTENSION_LIBRARIES = [] if platform.system() == 'Windows' else ['dl']  # dlopen of the native error plugins
 
 dl85_extension = Extension(
     name=EXTENSION_NAME,
     language=EXTENSION_LANGUAGE,
     sources=EXTENSION_SOURCE_FILES,
     include_dirs=EXTENSION_INCLUDE_DIR,  # path for headers
+    libraries=EXTENSION_LIBRARIES,
     extra_compile_args=EXTENSION_BUILD_ARGS,
     extra_link_args=EXTENSION_BUILD_ARGS
 )